@@ -0,0 +1,51 @@
+#include "benchmark.hpp"
+#include "synthetic_graph.hpp"
+
+#include "data/tab_components.hpp"
+#include "data/tab_manager.hpp"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QTemporaryDir>
+
+namespace {
+
+const QString SUITE = "archive";
+const std::vector<int> SIZES = {250, 500, 1000, 2000};
+
+// save of a generated graph and open of the saved dcb into a new tab
+bool run(Report &report)
+{
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return false;
+    bool saved = true;
+    for (int n : SIZES) {
+        QFileInfo file(dir.filePath(QString("bench_%1.dcb").arg(n)));
+        {
+            // registered so the blocks use the uid manager of their own tab
+            auto tab = std::make_shared<TabComponents>(nullptr, file);
+            TabManager::instance().addTab(tab);
+            populate(*tab->getGraph(), n);
+            report.add(SUITE, "save", n, timeNs([&]() { saved = tab->save() && saved; }), n);
+            TabManager::instance().removeTab(*tab);
+        }
+        {
+            auto tab = std::make_shared<TabComponents>(nullptr, file);
+            TabManager::instance().addTab(tab);
+            report.add(SUITE,
+                       "open",
+                       n,
+                       timeNs([&]() { saved = tab->openExisting() && saved; }),
+                       n);
+            TabManager::instance().removeTab(*tab);
+        }
+        // the tab parts are deleted later, there is no event loop to do it
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+    return saved;
+}
+
+const bool REGISTERED = registerSuite(SUITE, run);
+
+} // namespace
@@ -0,0 +1,41 @@
+#include "benchmark.hpp"
+#include "synthetic_graph.hpp"
+
+#include "data/block_manager.hpp"
+#include "data/custom_graph.hpp"
+#include "engine/kedro.hpp"
+
+#include <QtNodes/NodeDelegateModelRegistry>
+
+namespace {
+
+const QString SUITE = "codegen";
+const std::vector<int> SIZES = {1250, 2500, 5000, 10000};
+
+// the generated file contents, without the kedro process or the file copies
+bool run(Report &report)
+{
+    for (int n : SIZES) {
+        CustomGraph graph(BlockManager::getRegistry());
+        populate(graph, n);
+        auto snapshot = graph.snapshot();
+        report.add(SUITE, "parameters.yml", n, timeNs([&]() {
+                       Kedro::serializeParameters(*snapshot);
+                   }),
+                   n);
+        report.add(SUITE, "catalog.yml", n, timeNs([&]() {
+                       Kedro::serializeCatalog(*snapshot);
+                   }),
+                   n);
+        report.add(SUITE, "pipeline.py", n, timeNs([&]() {
+                       Kedro::serializePipeline(*snapshot);
+                   }),
+                   n);
+    }
+    report.expectFlat(SUITE, "pipeline.py");
+    return true;
+}
+
+const bool REGISTERED = registerSuite(SUITE, run);
+
+} // namespace
@@ -0,0 +1,64 @@
+#include "benchmark.hpp"
+#include "synthetic_graph.hpp"
+
+#include "data/block_manager.hpp"
+#include "data/custom_graph.hpp"
+#include "ui/models/fdf_block_model.hpp"
+
+#include <QtNodes/NodeDelegateModelRegistry>
+
+namespace {
+
+const QString SUITE = "custom_graph";
+const QString BLOCK = "transform";
+const std::vector<int> SIZES = {1250, 2500, 5000, 10000};
+
+// adds n copies of the same block (the paste case), renames them all to the same caption so
+// every rename goes through the caption uniquing, then deletes them all (the selection delete)
+void copies(Report &report, int n)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    std::vector<QtNodes::NodeId> ids;
+    ids.reserve(n);
+
+    report.add(SUITE, "create", n, timeNs([&]() {
+                   for (int i = 0; i < n; ++i)
+                       ids.push_back(graph.addNode(BLOCK));
+               }),
+               n);
+    report.add(SUITE, "rename", n, timeNs([&]() {
+                   for (auto id : ids)
+                       graph.delegateModel<FdfBlockModel>(id)->setCaption("renamed");
+               }),
+               n);
+    report.add(SUITE, "delete", n, timeNs([&]() {
+                   for (auto id : ids)
+                       graph.deleteNode(id);
+               }),
+               n);
+}
+
+// the valid graph of the scalability tests, connection checks included
+void synthetic(Report &report, int n)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    SyntheticGraph generated;
+    report.add(SUITE, "populate", n, timeNs([&]() { generated = populate(graph, n); }), n);
+    report.add(SUITE, "snapshot", n, timeNs([&]() { graph.snapshot(); }), n);
+}
+
+bool run(Report &report)
+{
+    for (int n : SIZES) {
+        copies(report, n);
+        synthetic(report, n);
+    }
+    // per node cost should stay flat when the graph grows
+    for (const QString name : {"create", "rename", "delete", "populate"})
+        report.expectFlat(SUITE, name);
+    return true;
+}
+
+const bool REGISTERED = registerSuite(SUITE, run);
+
+} // namespace
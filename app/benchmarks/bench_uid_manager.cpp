@@ -0,0 +1,55 @@
+#include "benchmark.hpp"
+
+#include "ui/models/uid_manager.hpp"
+
+namespace {
+
+const QString SUITE = "uid_manager";
+const std::vector<int> SIZES = {1000, 2000, 4000, 8000};
+
+bool run(Report &report)
+{
+    for (int n : SIZES) {
+        // without a graph only the maps are measured, not the port refresh
+        UIDManager manager;
+        std::vector<FdfUID> ids;
+        ids.reserve(n);
+        report.add(SUITE, "createUID", n, timeNs([&]() {
+                       for (int i = 0; i < n; ++i)
+                           ids.push_back(manager.createUID());
+                   }),
+                   n);
+        // every tag is taken, each one has to be made unique
+        report.add(SUITE, "createUID same tag", n, timeNs([&]() {
+                       for (int i = 0; i < n; ++i)
+                           manager.createUID("flux");
+                   }),
+                   n);
+        report.add(SUITE, "updateMap rename", n, timeNs([&]() {
+                       for (int i = 0; i < n; ++i) {
+                           QString tag = QString("renamed_%1").arg(i);
+                           manager.updateMap(ids[i], tag);
+                       }
+                   }),
+                   n);
+        // merges every type into the first one, the user accepting a mismatch each time
+        report.add(SUITE, "updateMap override", n, timeNs([&]() {
+                       QString keep = manager.getTag(ids.front());
+                       for (int i = 1; i < n; ++i) {
+                           QString tag = keep;
+                           manager.updateMap(ids[i], tag);
+                       }
+                   }),
+                   n - 1);
+        report.add(SUITE, "resolve", n, timeNs([&]() {
+                       for (auto id : ids)
+                           manager.resolve(id);
+                   }),
+                   n);
+    }
+    return true;
+}
+
+const bool REGISTERED = registerSuite(SUITE, run);
+
+} // namespace
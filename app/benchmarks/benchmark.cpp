@@ -0,0 +1,53 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+
+namespace {
+std::vector<std::pair<QString, Suite>> &registry()
+{
+    static std::vector<std::pair<QString, Suite>> suites;
+    return suites;
+}
+} // namespace
+
+void Report::add(const QString &suite, const QString &name, int size, qint64 ns, qint64 operations)
+{
+    m_measurements.push_back({suite, name, size, ns, operations});
+}
+
+double Report::growth(const QString &suite, const QString &name) const
+{
+    const Measurement *smallest = nullptr;
+    const Measurement *largest = nullptr;
+    for (const auto &m : m_measurements) {
+        if (m.suite != suite || m.name != name)
+            continue;
+        if (!smallest || m.size < smallest->size)
+            smallest = &m;
+        if (!largest || m.size > largest->size)
+            largest = &m;
+    }
+    if (!smallest || smallest->nsPerOperation() <= 0)
+        return 1.0;
+    return largest->nsPerOperation() / smallest->nsPerOperation();
+}
+
+void Report::expectFlat(const QString &suite, const QString &name)
+{
+    m_flat.emplace_back(suite, name);
+}
+
+bool registerSuite(const QString &name, const Suite &suite)
+{
+    registry().emplace_back(name, suite);
+    // static registration order depends on the link order, keep the runs comparable
+    std::sort(registry().begin(), registry().end(), [](const auto &a, const auto &b) {
+        return a.first < b.first;
+    });
+    return true;
+}
+
+const std::vector<std::pair<QString, Suite>> &suites()
+{
+    return registry();
+}
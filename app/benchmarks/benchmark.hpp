@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// One timed operation at one problem size
+struct Measurement
+{
+    QString suite;
+    QString name;
+    int size;
+    qint64 ns;
+    qint64 operations; // the reported cost is per operation
+    double nsPerOperation() const { return double(ns) / std::max<qint64>(operations, 1); }
+};
+
+class Report
+{
+public:
+    void add(const QString &suite, const QString &name, int size, qint64 ns, qint64 operations);
+    // per operation cost at the largest size over the one at the smallest, 1 when flat
+    double growth(const QString &suite, const QString &name) const;
+    // the per operation cost should not grow with the size. The growth is reported, the run
+    // only fails on it with --max-growth, wall clock ratios are noisy on shared machines.
+    void expectFlat(const QString &suite, const QString &name);
+    const std::vector<Measurement> &measurements() const { return m_measurements; }
+    const std::vector<std::pair<QString, QString>> &flat() const { return m_flat; }
+
+private:
+    std::vector<Measurement> m_measurements;
+    std::vector<std::pair<QString, QString>> m_flat; // suite, name
+};
+
+// A suite adds its measurements to the report and returns false when one of its checks failed.
+// Suites register themselves from their own file with a static registerSuite call.
+using Suite = std::function<bool(Report &report)>;
+bool registerSuite(const QString &name, const Suite &suite);
+const std::vector<std::pair<QString, Suite>> &suites();
+
+template<typename F>
+qint64 timeNs(F &&function)
+{
+    QElapsedTimer timer;
+    timer.start();
+    function();
+    return timer.nsecsElapsed();
+}
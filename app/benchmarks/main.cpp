@@ -0,0 +1,147 @@
+#include "benchmark.hpp"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTextStream>
+
+#include <map>
+
+namespace {
+
+QString key(const QString &suite, const QString &name, int size)
+{
+    return QString("%1/%2/%3").arg(suite, name, QString::number(size));
+}
+
+// per operation cost of every measurement of a previous --json run
+std::map<QString, double> readBaseline(const QString &path)
+{
+    std::map<QString, double> baseline;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot open baseline" << path << file.errorString();
+        return baseline;
+    }
+    for (const auto &value : QJsonDocument::fromJson(file.readAll())["results"].toArray()) {
+        auto result = value.toObject();
+        baseline[key(result["suite"].toString(),
+                     result["name"].toString(),
+                     result["size"].toInt())]
+            = result["ns_per_op"].toDouble();
+    }
+    return baseline;
+}
+
+bool writeJson(const QString &path, const Report &report)
+{
+    QJsonArray results;
+    for (const auto &m : report.measurements())
+        results.append(QJsonObject{{"suite", m.suite},
+                                   {"name", m.name},
+                                   {"size", m.size},
+                                   {"ns", m.ns},
+                                   {"operations", m.operations},
+                                   {"ns_per_op", m.nsPerOperation()}});
+#ifdef NDEBUG
+    const QString build = "release";
+#else
+    const QString build = "debug";
+#endif
+    QJsonObject root{{"timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+                     {"qt", qVersion()},
+                     {"cpu", QSysInfo::currentCpuArchitecture()},
+                     {"build", build},
+                     {"results", results}};
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot write" << path << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    QApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption jsonOption("json", "Write the results as json to <file>.", "file");
+    QCommandLineOption baselineOption("baseline",
+                                      "Compare with the json results of a previous run.",
+                                      "file");
+    QCommandLineOption listOption("list", "List the suites.");
+    QCommandLineOption maxGrowthOption("max-growth",
+                                       "Fail when the per operation cost of a flat measurement "
+                                       "grows more than <ratio> times over the sizes.",
+                                       "ratio");
+    parser.addOptions({jsonOption, baselineOption, listOption, maxGrowthOption});
+    parser.addPositionalArgument("suites",
+                                 "Suites to run, all when none are given.",
+                                 "[suites...]");
+    parser.process(app);
+    // only gated on request, the ratio of wall clock times is noisy on loaded machines
+    const bool gateGrowth = parser.isSet(maxGrowthOption);
+    bool maxGrowthValid = true;
+    const double maxGrowth = parser.value(maxGrowthOption).toDouble(&maxGrowthValid);
+    if (gateGrowth && (!maxGrowthValid || maxGrowth <= 0)) {
+        qWarning() << "Invalid --max-growth" << parser.value(maxGrowthOption);
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    if (parser.isSet(listOption)) {
+        for (const auto &[name, suite] : suites())
+            out << name << '\n';
+        return 0;
+    }
+
+    const QStringList selected = parser.positionalArguments();
+    Report report;
+    bool passed = true;
+    for (const auto &[name, suite] : suites()) {
+        if (!selected.isEmpty() && !selected.contains(name))
+            continue;
+        if (!suite(report)) {
+            out << name << ": check failed\n";
+            passed = false;
+        }
+    }
+
+    std::map<QString, double> baseline;
+    if (parser.isSet(baselineOption))
+        baseline = readBaseline(parser.value(baselineOption));
+    out << "suite\tname\tsize\tus/op" << (baseline.empty() ? "" : "\tvs baseline") << '\n';
+    for (const auto &m : report.measurements()) {
+        out << m.suite << '\t' << m.name << '\t' << m.size << '\t' << m.nsPerOperation() / 1000.0;
+        auto it = baseline.find(key(m.suite, m.name, m.size));
+        if (it != baseline.end() && it->second > 0)
+            out << '\t' << m.nsPerOperation() / it->second << 'x';
+        out << '\n';
+    }
+
+    if (!report.flat().empty())
+        out << "\nsuite\tname\tgrowth\n";
+    for (const auto &[suite, name] : report.flat()) {
+        double growth = report.growth(suite, name);
+        out << suite << '\t' << name << '\t' << growth << 'x';
+        if (gateGrowth && growth >= maxGrowth) {
+            out << "\tover " << maxGrowth << 'x';
+            passed = false;
+        }
+        out << '\n';
+    }
+
+    if (parser.isSet(jsonOption) && !writeJson(parser.value(jsonOption), report))
+        return 1;
+    return passed ? 0 : 1;
+}
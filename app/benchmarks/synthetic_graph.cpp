@@ -0,0 +1,84 @@
+#include "synthetic_graph.hpp"
+
+#include "data/custom_graph.hpp"
+#include "ui/models/function_names.hpp"
+#include "ui/models/io_models.hpp"
+
+#include <QFileInfo>
+
+namespace {
+
+class Generator
+{
+public:
+    explicit Generator(CustomGraph &graph)
+        : m_graph(graph)
+    {}
+
+    SyntheticGraph populate(int blocks, int fanOut, int chainLength)
+    {
+        auto target = dataSource("target");
+        for (int unit = 0; int(m_result.nodes.size()) < blocks; ++unit) {
+            auto input = dataSource(QString("input_%1").arg(unit));
+            auto trainer = add("trainer");
+            connect(input, 0, trainer, 0);
+            connect(target, 0, trainer, 1);
+
+            QtNodes::NodeId last = QtNodes::InvalidNodeId;
+            for (int i = 0; i < fanOut; ++i) {
+                last = add("process");
+                connect(trainer, 0, last, 0);
+                connect(input, 0, last, 1);
+                sink(last);
+            }
+            for (int i = 0; i < chainLength; ++i) {
+                auto transform = add("transform");
+                connect(last, 0, transform, 0);
+                auto process = add("process");
+                connect(transform, 0, process, 0);
+                connect(last, 0, process, 1);
+                last = process;
+            }
+            sink(last);
+        }
+        return m_result;
+    }
+
+private:
+    QtNodes::NodeId add(const QString &name)
+    {
+        auto id = m_graph.addNode(name);
+        m_result.nodes.push_back(id);
+        return id;
+    }
+    QtNodes::NodeId dataSource(const QString &name)
+    {
+        auto id = add(io_names::DATA_SOURCE);
+        m_graph.delegateModel<DataSourceModel>(id)->setFile(QFileInfo(name + ".csv"));
+        return id;
+    }
+    void sink(QtNodes::NodeId out) { connect(out, 0, add(io_names::DATA_OUT), 0); }
+    void connect(QtNodes::NodeId out,
+                 QtNodes::PortIndex outPort,
+                 QtNodes::NodeId in,
+                 QtNodes::PortIndex inPort)
+    {
+        QtNodes::ConnectionId connection{out, outPort, in, inPort};
+        if (!m_graph.connectionPossible(connection)) {
+            m_result.valid = false;
+            return;
+        }
+        m_graph.addConnection(connection);
+        ++m_result.connections;
+    }
+
+    CustomGraph &m_graph;
+    SyntheticGraph m_result;
+};
+
+} // namespace
+
+SyntheticGraph populate(CustomGraph &graph, int blocks, int fanOut, int chainLength)
+{
+    return Generator(graph).populate(blocks, fanOut, chainLength);
+}
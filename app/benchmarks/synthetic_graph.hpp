@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QtNodes/Definitions>
+
+#include <vector>
+
+class CustomGraph;
+
+struct SyntheticGraph
+{
+    std::vector<QtNodes::NodeId> nodes;
+    size_t connections = 0;
+    bool valid = true; // false when the graph refused a connection
+};
+
+// A valid, connected graph of at least `blocks` blocks. Every unit has its own data source and
+// trainer sharing one target source, processors fanning out of the trainer and a chain of
+// transform -> process blocks, each ending in a data_out sink. The result only depends on the
+// arguments, so runs are comparable between commits. Shared by the benchmarks and the
+// scalability tests.
+SyntheticGraph populate(CustomGraph &graph, int blocks, int fanOut = 2, int chainLength = 4);
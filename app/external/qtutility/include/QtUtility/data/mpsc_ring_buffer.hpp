@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace QtUtility {
+namespace data {
+
+// Bounded lock-free queue for many producers and a single consumer.
+// Every slot carries a sequence number telling producers and the consumer whose turn it is,
+// so a push is one compare and swap on the write position and never blocks.
+template<typename T>
+class MpscRingBuffer
+{
+public:
+    // capacity is rounded up to a power of two
+    explicit MpscRingBuffer(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        m_mask = size - 1;
+        m_slots.reset(new Slot[size]);
+        for (size_t i = 0; i < size; ++i)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    MpscRingBuffer(const MpscRingBuffer &) = delete;
+    MpscRingBuffer &operator=(const MpscRingBuffer &) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // safe from any thread, returns false when the buffer is full
+    bool tryPush(T value)
+    {
+        size_t position = m_writePosition.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true) {
+            slot = &m_slots[position & m_mask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence)
+                              - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) {
+                if (m_writePosition.compare_exchange_weak(position,
+                                                          position + 1,
+                                                          std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false; // the consumer has not freed this slot yet
+            } else {
+                position = m_writePosition.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = std::move(value);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // only called from the consumer thread, returns false when the buffer is empty
+    bool tryPop(T &value)
+    {
+        Slot &slot = m_slots[m_readPosition & m_mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != m_readPosition + 1)
+            return false; // empty, or a producer is still writing the slot
+        value = std::move(slot.value);
+        slot.value = T();
+        slot.sequence.store(m_readPosition + m_mask + 1, std::memory_order_release);
+        ++m_readPosition;
+        return true;
+    }
+
+private:
+    // separate cache lines, producers and the consumer do not invalidate each other
+    static constexpr size_t CACHE_LINE = 64;
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask = 0;
+    alignas(CACHE_LINE) std::atomic<size_t> m_writePosition{0};
+    alignas(CACHE_LINE) size_t m_readPosition = 0;
+};
+
+} // namespace data
+} // namespace QtUtility
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QDateTime>
+#include <QImage>
+#include <QObject>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "QtUtility/data/qsingleton.hpp"
+#include "QtUtility/export.hpp"
+
+namespace QtUtility {
+namespace media {
+
+// Decodes images on a background pool and keeps the results in a memory bounded LRU cache.
+// Entries are keyed by path, modification time and bound, so a rewritten file is decoded again.
+// A decode that finishes after its file was rewritten is dropped and the new content decoded.
+class QTUTILITY_EXPORT ImageLoader : public QSingleton<ImageLoader>
+{
+    Q_OBJECT
+    friend class QSingleton<ImageLoader>;
+
+public:
+    using Callback = std::function<void(const QImage &)>;
+
+    ~ImageLoader() override;
+    // an invalid bound loads the image at full resolution
+    std::optional<QImage> cached(const QString &path, const QSize &bound = QSize());
+    // decodes in the background, loaded() is emitted on the thread of the loader
+    void request(const QString &path, const QSize &bound = QSize());
+    // also calls back once with the image, on the thread of the loader, unless context is
+    // destroyed before. The image is null when the file cannot be read.
+    void request(const QString &path,
+                 const QSize &bound,
+                 const QObject *context,
+                 Callback callback);
+    void setCacheLimit(qint64 bytes);
+    void clear();
+
+signals:
+    void loaded(const QString &path, const QSize &bound, const QImage &image);
+
+private:
+    ImageLoader();
+    QString key(const QString &path, const QSize &bound) const;
+    void insert(const QString &key, const QImage &image);
+    void evict();
+
+    QThreadPool m_pool;
+    // most recently used first
+    std::list<std::pair<QString, QImage>> m_entries;
+    std::unordered_map<QString, std::list<std::pair<QString, QImage>>::iterator> m_index;
+    std::unordered_set<QString> m_pending;
+    std::unordered_map<QString, std::vector<std::pair<QPointer<const QObject>, Callback>>>
+        m_callbacks; // by entry key
+    qint64 m_cacheBytes = 0;
+    qint64 m_cacheLimit;
+};
+
+} // namespace media
+} // namespace QtUtility
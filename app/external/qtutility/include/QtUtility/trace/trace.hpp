@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <chrono>
+
+#include "QtUtility/export.hpp"
+
+// QTUTILITY_TRACE_SCOPE("name") records the time until the end of the enclosing scope.
+// Names must be string literals. Scopes cost one relaxed load while tracing is off and
+// compile to nothing when QTUTILITY_TRACING is not defined.
+#ifdef QTUTILITY_TRACING
+#define QTUTILITY_TRACE_CONCAT_IMPL(a, b) a##b
+#define QTUTILITY_TRACE_CONCAT(a, b) QTUTILITY_TRACE_CONCAT_IMPL(a, b)
+#define QTUTILITY_TRACE_SCOPE(name) \
+    QtUtility::trace::Scope QTUTILITY_TRACE_CONCAT(traceScope, __LINE__)(name)
+#else
+#define QTUTILITY_TRACE_SCOPE(name) \
+    do { \
+    } while (false)
+#endif
+
+namespace QtUtility {
+namespace trace {
+
+namespace detail {
+QTUTILITY_EXPORT extern std::atomic<bool> enabled;
+} // namespace detail
+
+// events of each thread go to its own buffer, recording takes no lock
+inline bool isEnabled()
+{
+    return detail::enabled.load(std::memory_order_relaxed);
+}
+// starting drops the events of the previous session
+QTUTILITY_EXPORT void setEnabled(bool value);
+inline qint64 now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+// for spans that do not fit a scope, start and end come from now()
+QTUTILITY_EXPORT void record(const char *name, qint64 startNs, qint64 endNs);
+// microseconds since the unix epoch, the clock external processes stamp their events with
+QTUTILITY_EXPORT qint64 toEpochMicroseconds(qint64 ns);
+// writes the session as chrome trace_event json. Each line of the event files holds one
+// complete event object stamped in epoch microseconds, they are merged onto the same timeline.
+QTUTILITY_EXPORT bool writeChromeTrace(const QString &path,
+                                       const QStringList &eventFiles = QStringList());
+
+class Scope
+{
+public:
+    explicit Scope(const char *name)
+        : m_name(name)
+        , m_start(isEnabled() ? now() : -1)
+    {}
+    ~Scope()
+    {
+        if (m_start >= 0)
+            record(m_name, m_start, now());
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    const char *m_name;
+    qint64 m_start;
+};
+
+} // namespace trace
+} // namespace QtUtility
@@ -2,12 +2,15 @@
 
 #include <QAbstractListModel>
 #include <QPixmap>
+#include <QSize>
 
 #include "QtUtility/export.hpp"
 
 namespace QtUtility {
 namespace widgets {
 
+// Images are either held in memory or referenced by path. Path images only keep a thumbnail,
+// decoded in the background, the full image is read when asked for with at().
 class QTUTILITY_EXPORT ImageListModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -17,13 +20,26 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     size_t count() const;
     QPixmap at(const size_t &index) const;
+    QString pathAt(const size_t &index) const;
+    QStringList paths() const;
     void add(const QPixmap &pixmap);
+    void add(const QString &path);
     void remove(int index);
     void clear();
+    void setThumbnailSize(const QSize &size) { m_thumbnailSize = size; }
+
+private slots:
+    void onImageLoaded(const QString &path, const QSize &bound, const QImage &image);
 
 private:
-    QList<QPixmap> m_images;
+    struct Image
+    {
+        QString path;
+        QPixmap pixmap; // full image when not backed by a file, otherwise the thumbnail
+    };
+    QList<Image> m_images;
+    QSize m_thumbnailSize;
 };
 
 } // namespace widgets
-} // namespace QtUtility
\ No newline at end of file
+} // namespace QtUtility
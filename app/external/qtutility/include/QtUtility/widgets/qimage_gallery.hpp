@@ -21,6 +21,8 @@ public:
     QPixmap at(const size_t &index) const;
     void add(const QPixmap &image);
     void add(const QString &path);
+    // replaces the images, nothing is reloaded when the files are unchanged
+    void setImages(const QStringList &paths);
     void remove(const size_t &index);
     void clear();
 
@@ -29,12 +31,16 @@ signals:
 
 private slots:
     void onImageSelected();
+    void onImageLoaded(const QString &path, const QSize &bound, const QImage &image);
     void downloadAllClicked();
 
 private:
     void clearViewer();
+    void showImage(const QPixmap &image);
 
     ImageListModel *m_images;
+    QStringList m_fileKeys; // path and modification time of the images set by setImages
+    QString m_selectedPath;
 
     QListView *m_list;
     // could be upgraded to a QGraphicsScene if we need more capabilities
@@ -0,0 +1,150 @@
+#include "QtUtility/media/image_loader.hpp"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QImageReader>
+
+#include "QtUtility/trace/trace.hpp"
+
+namespace {
+constexpr qint64 DEFAULT_CACHE_LIMIT = 64 * 1024 * 1024; // bytes
+constexpr int DECODE_THREADS = 2;
+
+QImage decode(const QString &path, const QSize &bound)
+{
+    QTUTILITY_TRACE_SCOPE("decode image");
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+    QSize size = reader.size();
+    if (bound.isValid() && size.isValid()
+        && (size.width() > bound.width() || size.height() > bound.height()))
+        reader.setScaledSize(size.scaled(bound, Qt::KeepAspectRatio));
+    QImage image = reader.read();
+    if (image.isNull())
+        qWarning() << "ImageLoader: Cannot read" << path << reader.errorString();
+    return image;
+}
+} // namespace
+
+namespace QtUtility {
+namespace media {
+
+ImageLoader::ImageLoader()
+    : m_cacheLimit(DEFAULT_CACHE_LIMIT)
+{
+    m_pool.setMaxThreadCount(DECODE_THREADS);
+}
+
+ImageLoader::~ImageLoader()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+std::optional<QImage> ImageLoader::cached(const QString &path, const QSize &bound)
+{
+    auto it = m_index.find(key(path, bound));
+    if (it == m_index.end())
+        return std::nullopt;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->second;
+}
+
+void ImageLoader::request(const QString &path, const QSize &bound)
+{
+    request(path, bound, nullptr, Callback());
+}
+
+void ImageLoader::request(const QString &path,
+                          const QSize &bound,
+                          const QObject *context,
+                          Callback callback)
+{
+    QString entryKey = key(path, bound);
+    if (auto image = cached(path, bound)) {
+        if (context && callback)
+            callback(image.value());
+        emit loaded(path, bound, image.value());
+        return;
+    }
+    if (context && callback)
+        m_callbacks[entryKey].emplace_back(context, std::move(callback));
+    if (!m_pending.insert(entryKey).second)
+        return; // already decoding
+    m_pool.start([this, path, bound, entryKey]() {
+        QImage image = decode(path, bound);
+        QMetaObject::invokeMethod(
+            this,
+            [this, path, bound, entryKey, image]() {
+                m_pending.erase(entryKey);
+                auto callbacks = std::move(m_callbacks[entryKey]);
+                m_callbacks.erase(entryKey);
+                // the image is of the content before the file was rewritten
+                if (key(path, bound) != entryKey) {
+                    bool requested = false;
+                    for (auto &[context, callback] : callbacks)
+                        if (context) {
+                            request(path, bound, context, std::move(callback));
+                            requested = true;
+                        }
+                    if (!requested)
+                        request(path, bound);
+                    return;
+                }
+                if (!image.isNull())
+                    insert(entryKey, image);
+                for (const auto &[context, callback] : callbacks)
+                    if (context)
+                        callback(image);
+                emit loaded(path, bound, image);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void ImageLoader::setCacheLimit(qint64 bytes)
+{
+    m_cacheLimit = bytes;
+    evict();
+}
+
+void ImageLoader::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_cacheBytes = 0;
+}
+
+QString ImageLoader::key(const QString &path, const QSize &bound) const
+{
+    QFileInfo info(path);
+    return QString("%1|%2|%3x%4")
+        .arg(info.absoluteFilePath(),
+             QString::number(info.lastModified().toMSecsSinceEpoch()),
+             QString::number(bound.width()),
+             QString::number(bound.height()));
+}
+
+void ImageLoader::insert(const QString &key, const QImage &image)
+{
+    if (m_index.count(key) > 0)
+        return;
+    m_entries.emplace_front(key, image);
+    m_index[key] = m_entries.begin();
+    m_cacheBytes += image.sizeInBytes();
+    evict();
+}
+
+void ImageLoader::evict()
+{
+    // the newest entry is kept even when it is larger than the limit
+    while (m_cacheBytes > m_cacheLimit && m_entries.size() > 1) {
+        auto &last = m_entries.back();
+        m_cacheBytes -= last.second.sizeInBytes();
+        m_index.erase(last.first);
+        m_entries.pop_back();
+    }
+}
+
+} // namespace media
+} // namespace QtUtility
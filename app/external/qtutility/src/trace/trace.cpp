@@ -0,0 +1,179 @@
+#include "QtUtility/trace/trace.hpp"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QThread>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr size_t EVENTS_PER_THREAD = 1 << 16; // the oldest events are overwritten
+
+struct Event
+{
+    const char *name;
+    qint64 start;
+    qint64 end;
+};
+
+// written only by its thread, count is published after the event
+struct ThreadBuffer
+{
+    int id;
+    QString name;
+    std::unique_ptr<Event[]> events{new Event[EVENTS_PER_THREAD]};
+    std::atomic<size_t> count{0};
+};
+
+// buffers outlive their threads, pool threads keep reusing theirs
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+thread_local ThreadBuffer *threadBuffer = nullptr;
+std::atomic<qint64> sessionStart{0};
+
+// steady clock zero expressed in epoch microseconds, taken once
+const qint64 EPOCH_OFFSET_US = []() {
+    auto epoch = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::system_clock::now().time_since_epoch())
+                     .count();
+    return epoch - QtUtility::trace::now() / 1000;
+}();
+
+ThreadBuffer *currentBuffer()
+{
+    if (threadBuffer)
+        return threadBuffer;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.push_back(std::make_unique<ThreadBuffer>());
+    threadBuffer = registry.back().get();
+    threadBuffer->id = int(registry.size());
+    auto app = QCoreApplication::instance();
+    if (app && QThread::currentThread() == app->thread())
+        threadBuffer->name = "main";
+    else
+        threadBuffer->name = QThread::currentThread()->objectName();
+    if (threadBuffer->name.isEmpty())
+        threadBuffer->name = QString("thread %1").arg(threadBuffer->id);
+    return threadBuffer;
+}
+
+QString escaped(const QString &string)
+{
+    // a json string literal with its quotes
+    QString document = QString::fromUtf8(
+        QJsonDocument(QJsonObject{{"s", string}}).toJson(QJsonDocument::Compact));
+    return document.mid(5, document.size() - 6);
+}
+
+} // namespace
+
+namespace QtUtility {
+namespace trace {
+
+std::atomic<bool> detail::enabled{false};
+
+void setEnabled(bool value)
+{
+    if (value && !isEnabled())
+        sessionStart.store(now(), std::memory_order_relaxed);
+    detail::enabled.store(value, std::memory_order_relaxed);
+}
+
+void record(const char *name, qint64 startNs, qint64 endNs)
+{
+    ThreadBuffer *buffer = currentBuffer();
+    size_t count = buffer->count.load(std::memory_order_relaxed);
+    buffer->events[count % EVENTS_PER_THREAD] = {name, startNs, endNs};
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+qint64 toEpochMicroseconds(qint64 ns)
+{
+    return EPOCH_OFFSET_US + ns / 1000;
+}
+
+bool writeChromeTrace(const QString &path, const QStringList &eventFiles)
+{
+    // events recorded while writing may be overwritten under us, stop tracing before dumping
+    if (isEnabled())
+        qWarning() << "trace: Writing while tracing is enabled, recent events may be torn.";
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "trace: Cannot open" << path << file.errorString();
+        return false;
+    }
+    QTextStream out(&file);
+    const qint64 pid = QCoreApplication::applicationPid();
+    const qint64 start = sessionStart.load(std::memory_order_relaxed);
+    QString separator = "\n";
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    // every argument is substituted at once, names containing %1 are left alone
+    const QString pidString = QString::number(pid);
+    out << separator
+        << QString("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%1,\"args\":{\"name\":%2}}")
+               .arg(pidString, escaped(QCoreApplication::applicationName()));
+    separator = ",\n";
+
+    size_t events = 0;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto &buffer : registry) {
+            out << separator
+                << QString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%1,\"tid\":%2,"
+                           "\"args\":{\"name\":%3}}")
+                       .arg(pidString, QString::number(buffer->id), escaped(buffer->name));
+            size_t count = buffer->count.load(std::memory_order_acquire);
+            size_t first = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD : 0;
+            for (size_t i = first; i < count; ++i) {
+                const Event &event = buffer->events[i % EVENTS_PER_THREAD];
+                if (event.start < start)
+                    continue;
+                out << separator
+                    << QString("{\"name\":%1,\"cat\":\"builder\",\"ph\":\"X\",\"ts\":%2,"
+                               "\"dur\":%3,\"pid\":%4,\"tid\":%5}")
+                           .arg(escaped(QString::fromUtf8(event.name)),
+                                QString::number(toEpochMicroseconds(event.start)),
+                                QString::number((event.end - event.start) / 1000),
+                                pidString,
+                                QString::number(buffer->id));
+                ++events;
+            }
+        }
+    }
+
+    for (const auto &eventFile : eventFiles) {
+        QFile input(eventFile);
+        if (!input.exists())
+            continue;
+        if (!input.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qWarning() << "trace: Cannot read" << eventFile << input.errorString();
+            continue;
+        }
+        while (!input.atEnd()) {
+            QByteArray line = input.readLine().trimmed();
+            // a process killed mid write leaves a partial line behind
+            if (QJsonDocument::fromJson(line).isObject()) {
+                out << separator << QString::fromUtf8(line);
+                ++events;
+            }
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+    if (file.error() != QFile::NoError) {
+        qWarning() << "trace: Cannot write" << path << file.errorString();
+        return false;
+    }
+    qInfo() << "trace: Wrote" << events << "events to" << path;
+    return true;
+}
+
+} // namespace trace
+} // namespace QtUtility
@@ -2,12 +2,23 @@
 
 #include <QIcon>
 
+#include "QtUtility/media/image_loader.hpp"
+
+namespace {
+constexpr int DEFAULT_THUMBNAIL_SIZE = 100;
+} // namespace
+
 namespace QtUtility {
 namespace widgets {
 
+using ImageLoader = QtUtility::media::ImageLoader;
+
 ImageListModel::ImageListModel(QObject *parent)
     : QAbstractListModel(parent)
-{}
+    , m_thumbnailSize(DEFAULT_THUMBNAIL_SIZE, DEFAULT_THUMBNAIL_SIZE)
+{
+    connect(&ImageLoader::instance(), &ImageLoader::loaded, this, &ImageListModel::onImageLoaded);
+}
 
 int ImageListModel::rowCount(const QModelIndex &parent) const
 {
@@ -20,7 +31,9 @@ QVariant ImageListModel::data(const QModelIndex &index, int role) const
     if (!index.isValid() || index.row() >= m_images.size())
         return QVariant();
     if (role == Qt::DecorationRole)
-        return QIcon(m_images.at(index.row()));
+        return QIcon(m_images.at(index.row()).pixmap);
+    if (role == Qt::ToolTipRole)
+        return m_images.at(index.row()).path;
     return QVariant();
 }
 
@@ -31,16 +44,45 @@ size_t ImageListModel::count() const
 
 QPixmap ImageListModel::at(const size_t &index) const
 {
-    if (index < 0 || index > count())
+    if (index >= count())
         return QPixmap();
-    return m_images.at(index);
+    const Image &image = m_images.at(index);
+    if (image.path.isEmpty())
+        return image.pixmap;
+    if (auto cached = ImageLoader::instance().cached(image.path))
+        return QPixmap::fromImage(cached.value());
+    return QPixmap(image.path);
+}
+
+QString ImageListModel::pathAt(const size_t &index) const
+{
+    if (index >= count())
+        return QString();
+    return m_images.at(index).path;
+}
+
+QStringList ImageListModel::paths() const
+{
+    QStringList result;
+    for (const auto &image : m_images)
+        result.append(image.path);
+    return result;
 }
 
 void ImageListModel::add(const QPixmap &pixmap)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
-    m_images.append(pixmap);
+    m_images.append({QString(), pixmap});
+    endInsertRows();
+}
+
+void ImageListModel::add(const QString &path)
+{
+    beginInsertRows(QModelIndex(), rowCount(), rowCount());
+    m_images.append({path, QPixmap()});
     endInsertRows();
+    // the thumbnail is set when decoded, straight away when it is cached
+    ImageLoader::instance().request(path, m_thumbnailSize);
 }
 
 void ImageListModel::remove(int index)
@@ -59,5 +101,17 @@ void ImageListModel::clear()
     endResetModel();
 }
 
+void ImageListModel::onImageLoaded(const QString &path, const QSize &bound, const QImage &image)
+{
+    if (bound != m_thumbnailSize || image.isNull())
+        return;
+    for (int row = 0; row < m_images.size(); ++row) {
+        if (m_images.at(row).path != path)
+            continue;
+        m_images[row].pixmap = QPixmap::fromImage(image);
+        emit dataChanged(index(row), index(row), {Qt::DecorationRole});
+    }
+}
+
 } // namespace widgets
-} // namespace QtUtility
\ No newline at end of file
+} // namespace QtUtility
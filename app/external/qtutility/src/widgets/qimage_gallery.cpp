@@ -1,7 +1,9 @@
 #include "QtUtility/widgets/qimage_gallery.hpp"
 
+#include <QDateTime>
 #include <QDir>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QLabel>
 #include <QListView>
 #include <QPushButton>
@@ -10,6 +12,7 @@
 
 #include "QtUtility/widgets/image_list_model.hpp"
 #include <QtUtility/data/constexpr_qstring.hpp>
+#include <QtUtility/media/image_loader.hpp>
 #include <QtUtility/media/media.hpp>
 
 using ConstLatin1String = QtUtility::data::ConstLatin1String;
@@ -23,6 +26,8 @@ constexpr ConstLatin1String NO_SELECTION_TEXT = "No Image Selected.";
 namespace QtUtility {
 namespace widgets {
 
+using ImageLoader = QtUtility::media::ImageLoader;
+
 QImageGallery::QImageGallery(QWidget *parent)
     : QWidget(parent)
     , m_images(new ImageListModel)
@@ -30,6 +35,7 @@ QImageGallery::QImageGallery(QWidget *parent)
     auto layout = new QVBoxLayout(this);
 
     m_list = new QListView;
+    m_images->setThumbnailSize(QSize(ICON_SIZE, ICON_SIZE));
     m_list->setModel(m_images);
     m_list->setViewMode(QListView::IconMode);
     m_list->setIconSize(QSize(ICON_SIZE, ICON_SIZE));
@@ -52,6 +58,7 @@ QImageGallery::QImageGallery(QWidget *parent)
             this,
             &QImageGallery::onImageSelected,
             Qt::QueuedConnection);
+    connect(&ImageLoader::instance(), &ImageLoader::loaded, this, &QImageGallery::onImageLoaded);
     connect(downloadButton, &QPushButton::clicked, this, &QImageGallery::downloadAllClicked);
     connect(this, &QImageGallery::hasImage, downloadButton, &QPushButton::setEnabled);
 }
@@ -75,10 +82,26 @@ void QImageGallery::add(const QPixmap &image)
 
 void QImageGallery::add(const QString &path)
 {
-    QPixmap image(path);
-    if (image.isNull())
+    if (!QFileInfo::exists(path))
+        return;
+    m_images->add(path);
+    if (m_images->count() == 1)
+        emit hasImage(true);
+}
+
+void QImageGallery::setImages(const QStringList &paths)
+{
+    QStringList keys;
+    for (const auto &path : paths) {
+        QFileInfo info(path);
+        keys << path + '|' + QString::number(info.lastModified().toMSecsSinceEpoch());
+    }
+    if (keys == m_fileKeys && !m_fileKeys.isEmpty())
         return;
-    add(image);
+    clear();
+    m_fileKeys = keys;
+    for (const auto &path : paths)
+        add(path);
 }
 
 void QImageGallery::remove(const size_t &index)
@@ -91,7 +114,9 @@ void QImageGallery::remove(const size_t &index)
 void QImageGallery::clear()
 {
     clearViewer();
+    m_fileKeys.clear();
     m_images->clear();
+    emit hasImage(false);
 }
 
 void QImageGallery::downloadAllClicked()
@@ -106,6 +131,13 @@ void QImageGallery::downloadAllClicked()
     target.mkpath(".");
     for (int i = 0; i < m_images->count(); ++i) {
         QString path = target.absoluteFilePath(QString("graph%1.png").arg(i + 1));
+        // file backed images are copied as they are, without decoding them
+        QString source = m_images->pathAt(i);
+        if (!source.isEmpty() && source.endsWith(".png", Qt::CaseInsensitive)) {
+            QFile::remove(path);
+            if (QFile::copy(source, path))
+                continue;
+        }
         if (!m_images->at(i).save(path, "PNG")) {
             qCritical() << "Failed to save png: " << path;
             return;
@@ -116,21 +148,38 @@ void QImageGallery::downloadAllClicked()
 
 void QImageGallery::clearViewer()
 {
+    m_selectedPath.clear();
     m_viewer->clear();
     m_viewer->setText(NO_SELECTION_TEXT);
 }
 
+void QImageGallery::showImage(const QPixmap &image)
+{
+    m_viewer->setPixmap(image.scaledToWidth(IMAGE_WIDTH, Qt::SmoothTransformation));
+}
+
 void QImageGallery::onImageSelected()
 {
     QItemSelectionModel *selectionModel = m_list->selectionModel();
     if (selectionModel->selectedIndexes().isEmpty()) {
         clearViewer();
     } else {
+        // only the selected image is loaded at full resolution
         QModelIndex index = selectionModel->currentIndex();
-        m_viewer->setPixmap(
-            m_images->at(index.row()).scaledToWidth(IMAGE_WIDTH, Qt::SmoothTransformation));
+        m_selectedPath = m_images->pathAt(index.row());
+        if (m_selectedPath.isEmpty())
+            showImage(m_images->at(index.row()));
+        else
+            ImageLoader::instance().request(m_selectedPath);
     }
 }
 
+void QImageGallery::onImageLoaded(const QString &path, const QSize &bound, const QImage &image)
+{
+    if (bound.isValid() || path != m_selectedPath || image.isNull())
+        return;
+    showImage(QPixmap::fromImage(image));
+}
+
 } // namespace widgets
 } // namespace QtUtility
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <QtUtility/media/image_loader.hpp>
+
+using QtUtility::media::ImageLoader;
+
+namespace {
+
+// the loader reports on its own thread, run the event loop until done
+bool waitFor(const std::function<bool()> &done, int timeoutMsecs = 5000)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done() && timer.elapsed() < timeoutMsecs)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    return done();
+}
+
+} // namespace
+
+TEST(ImageLoaderTest, CallsBackTheRequesterOnly)
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("image.png");
+    QImage source(8, 4, QImage::Format_RGB32);
+    source.fill(Qt::red);
+    ASSERT_TRUE(source.save(path));
+    ImageLoader::instance().clear();
+
+    QObject requester;
+    auto gone = std::make_unique<QObject>();
+    int calls = 0;
+    int goneCalls = 0;
+    QSize size;
+    ImageLoader::instance().request(path, QSize(), &requester, [&](const QImage &image) {
+        ++calls;
+        size = image.size();
+    });
+    ImageLoader::instance().request(path, QSize(), gone.get(), [&](const QImage &) {
+        ++goneCalls;
+    });
+    gone.reset();
+    ASSERT_TRUE(waitFor([&calls]() { return calls > 0; }));
+    EXPECT_EQ(size, QSize(8, 4));
+    EXPECT_EQ(goneCalls, 0) << "Destroyed requesters are not called back.";
+
+    // cached images are handed back right away
+    ImageLoader::instance().request(path, QSize(), &requester, [&](const QImage &) { ++calls; });
+    EXPECT_EQ(calls, 2);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <QtUtility/data/mpsc_ring_buffer.hpp>
+
+using QtUtility::data::MpscRingBuffer;
+
+TEST(MpscRingBufferTest, RejectsPushWhenFull)
+{
+    MpscRingBuffer<int> buffer(3);
+    ASSERT_EQ(buffer.capacity(), 4u);
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(buffer.tryPush(i));
+    EXPECT_FALSE(buffer.tryPush(4));
+
+    int value = -1;
+    ASSERT_TRUE(buffer.tryPop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(buffer.tryPush(4)) << "Popping should free a slot.";
+}
+
+TEST(MpscRingBufferTest, KeepsOrderOfEachProducer)
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int MESSAGES = 20000;
+    MpscRingBuffer<std::pair<int, int>> buffer(256);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCERS; ++producer)
+        producers.emplace_back([&buffer, producer]() {
+            for (int i = 0; i < MESSAGES; ++i)
+                while (!buffer.tryPush({producer, i}))
+                    std::this_thread::yield();
+        });
+
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    std::pair<int, int> value;
+    while (received < PRODUCERS * MESSAGES) {
+        if (!buffer.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value.second, next[value.first]) << "Producer " << value.first;
+        ++next[value.first];
+        ++received;
+    }
+    for (auto &thread : producers)
+        thread.join();
+    EXPECT_FALSE(buffer.tryPop(value));
+}
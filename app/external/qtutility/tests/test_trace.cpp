@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <QtUtility/trace/trace.hpp>
+
+namespace trace = QtUtility::trace;
+
+namespace {
+QJsonArray namedEvents(const QJsonArray &events, const QString &name)
+{
+    QJsonArray named;
+    for (const auto &event : events)
+        if (event.toObject()["name"].toString() == name)
+            named.append(event);
+    return named;
+}
+} // namespace
+
+TEST(TraceTest, WritesSessionAndMergesEventFiles)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString eventFile = dir.filePath("events.jsonl");
+    {
+        QFile file(eventFile);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("{\"name\":\"node\",\"ph\":\"X\",\"ts\":1,\"dur\":2,\"pid\":3,\"tid\":4}\n");
+        file.write("{\"name\":\"torn\""); // killed mid write
+    }
+
+    trace::record("before session", trace::now(), trace::now());
+    trace::setEnabled(true);
+    {
+        QTUTILITY_TRACE_SCOPE("scope %1");
+    }
+    trace::setEnabled(false);
+    {
+        QTUTILITY_TRACE_SCOPE("after session");
+    }
+
+    QString path = dir.filePath("trace.json");
+    ASSERT_TRUE(trace::writeChromeTrace(path, {eventFile, dir.filePath("missing.jsonl")}));
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    auto events = QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray();
+
+#ifdef QTUTILITY_TRACING
+    EXPECT_EQ(namedEvents(events, "scope %1").size(), 1);
+#endif
+    EXPECT_TRUE(namedEvents(events, "before session").isEmpty());
+    EXPECT_TRUE(namedEvents(events, "after session").isEmpty());
+    ASSERT_EQ(namedEvents(events, "node").size(), 1);
+    EXPECT_EQ(namedEvents(events, "node")[0].toObject()["tid"].toInt(), 4);
+}
@@ -23,10 +23,14 @@ public:
     FdfBlockModel *getBlock(QtNodes::NodeId id) const;
     QPointF getBlockPosition(QtNodes::NodeId id) const;
     void setBlockPosition(QtNodes::NodeId id, QPointF point);
+    // of the current scene, as of the last selection change
+    const std::vector<QtNodes::NodeId> &selectedNodes() const { return m_selectedNodes; }
 
 signals:
     void nodeSelected(QtNodes::NodeId id);
     void nodeUpdated(QtNodes::NodeId id);
+    // geometry only, kept apart so editors are not refreshed while a block is dragged
+    void nodePositionUpdated(QtNodes::NodeId id);
 
 public slots:
     void onSelectionChanged();
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "data/graph_snapshot.hpp"
 #include "ui/models/uid_manager.hpp"
+#include <QTimer>
 #include <QtNodes/DirectedAcyclicGraphModel>
 
 class FdfBlockModel;
@@ -18,11 +20,31 @@ public:
     std::vector<FuncOutModel *> getFuncOutModels() const;
     FdfBlockModel *getBlockByCaption(const QString &caption) const;
     bool connectionPossible(QtNodes::ConnectionId const connectionId) const override;
-    // rename out ports that are duplicates
+    // rename out ports that are duplicates, without propagate only renamed ports are updated
     void makeOutPortsUnique(const QtNodes::NodeId &nodeId,
                             FdfBlockModel *block,
-                            const QtNodes::PortIndex &index);
-    bool verifyBlocksValidity() const;
+                            const QtNodes::PortIndex &index,
+                            bool propagate = true);
+    // nodes whose out ports (data type or function signature) reference the type
+    std::vector<QtNodes::NodeId> nodesUsingType(const FdfUID &typeId) const;
+    // re-reads the types referenced by the out ports of the node
+    void indexNodeTypes(const QtNodes::NodeId &nodeId);
+    // while loading from a file, per node bookkeeping is deferred to endBulkLoad
+    void beginBulkLoad();
+    void endBulkLoad();
+    bool isBulkLoading() const { return m_bulkLoading; }
+    // while an update is open, propagations are collected and each dirty block is
+    // propagated once in topological order on the last commit
+    void beginUpdate();
+    void commitUpdate();
+    // returns true when the propagation of the node was collected by the open update
+    bool deferPropagation(const QtNodes::NodeId &nodeId);
+    // immutable copy of the graph, only the blocks changed since the last call are copied again
+    std::shared_ptr<const GraphSnapshot> snapshot() const;
+    // number of weakly connected components, kept up to date with a union-find
+    size_t componentCount() const;
+    // re-checks the blocks changed since the last validation and shows their problems
+    void revalidate();
 
 signals:
     void dataSourceModelImportClicked(const QtNodes::NodeId nodeId);
@@ -42,15 +64,71 @@ private:
     void makeCaptionUnique(const QtNodes::NodeId &nodeId, FdfBlockModel *block);
     // to set port colours for function nodes
     void stylePorts(const QtNodes::NodeId &nodeId, FdfBlockModel *block);
-    void makeOutPortsUnique(const QtNodes::NodeId &nodeId, FdfBlockModel *block);
+    void makeOutPortsUnique(const QtNodes::NodeId &nodeId,
+                            FdfBlockModel *block,
+                            bool propagate = true);
+    void releaseOutPortName(const QtNodes::NodeId &nodeId, const QtNodes::PortIndex &index);
+    void unindexNodeTypes(const QtNodes::NodeId &nodeId);
+    // marks the snapshot record and validation state of the block as stale
+    void onBlockChanged(const QtNodes::NodeId &nodeId);
+    QtNodes::NodeId findComponent(const QtNodes::NodeId &nodeId) const;
+    void uniteComponents(const QtNodes::NodeId &a, const QtNodes::NodeId &b) const;
+    void rebuildComponents() const;
 
 private:
-    // tracks node captions for uniqueness
+    // tracks node captions for uniqueness, with the reverse index node -> caption
     std::unordered_map<QString, QtNodes::NodeId> m_usedNodeCaptions;
-    std::unordered_set<QtNodes::NodeId> m_trackedNodes;
+    std::unordered_map<QtNodes::NodeId, QString> m_nodeCaptions;
     // tracks out port names for uniqueness, index is necessary for uniqueness amongst the node itself
     std::unordered_map<QString, std::pair<QtNodes::NodeId, QtNodes::PortIndex>> m_usedOutPortCaptions;
+    // reverse index node -> out port names, ordered by port index
+    std::unordered_map<QtNodes::NodeId, std::vector<QString>> m_outPortNames;
+    // last suffix handed out per base name
+    std::unordered_map<QString, uint> m_captionSuffixes;
+    std::unordered_map<QString, uint> m_outPortSuffixes;
+    // FdfUID -> nodes referencing it, with the reverse index node -> sorted FdfUIDs
+    std::unordered_map<FdfUID, std::unordered_set<QtNodes::NodeId>> m_typeUsers;
+    std::unordered_map<QtNodes::NodeId, std::vector<FdfUID>> m_nodeTypes;
+    bool m_bulkLoading = false;
+    int m_updateDepth = 0;
+    bool m_flushingUpdate = false;
+    QtNodes::NodeId m_flushingNode = QtNodes::InvalidNodeId;
+    std::unordered_set<QtNodes::NodeId> m_dirtyNodes;
+    std::vector<QtNodes::NodeId> m_bulkLoadedNodes;
     std::unordered_set<QtNodes::NodeId> m_dataSourceNodes;
     std::unordered_set<QtNodes::NodeId> m_funcSourceNodes;
     std::unordered_set<QtNodes::NodeId> m_funcOutNodes;
+    // snapshot cache, with the per node records that are still up to date
+    mutable std::shared_ptr<const GraphSnapshot> m_snapshot;
+    mutable std::unordered_map<QtNodes::NodeId, std::shared_ptr<const SnapshotNode>> m_snapshotNodes;
+    mutable std::unordered_set<QtNodes::NodeId> m_staleSnapshotNodes;
+    // union-find over the nodes, deletions are applied by a lazy rebuild
+    mutable std::unordered_map<QtNodes::NodeId, QtNodes::NodeId> m_componentParent;
+    mutable size_t m_componentCount = 0;
+    mutable bool m_componentsStale = false;
+    // blocks whose problems shown on the canvas need to be re-checked, coalesced by the timer
+    std::unordered_set<QtNodes::NodeId> m_staleValidation;
+    QTimer m_validationTimer;
+};
+
+// Scoped CustomGraph update, commits when it goes out of scope
+class GraphUpdate
+{
+public:
+    explicit GraphUpdate(CustomGraph *graph)
+        : m_graph(graph)
+    {
+        if (m_graph)
+            m_graph->beginUpdate();
+    }
+    ~GraphUpdate()
+    {
+        if (m_graph)
+            m_graph->commitUpdate();
+    }
+    GraphUpdate(const GraphUpdate &) = delete;
+    GraphUpdate &operator=(const GraphUpdate &) = delete;
+
+private:
+    CustomGraph *m_graph;
 };
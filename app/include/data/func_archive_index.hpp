@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QDir>
+#include <QString>
+
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// Parsed content of a saved function archive (.zip holding a dill .pkl and its metadata json)
+struct FuncArchiveEntry
+{
+    QString fileHash; // hash of the dcb that produced the function, used to remap the UIDs
+    QString functionName;
+    std::vector<int> inputs;
+    std::vector<int> outputs;
+    QString dillPath;
+};
+
+// Persistent index of imported function archives, keyed by the archive content hash.
+// The archive is read in a single pass: the metadata is parsed in memory and the .pkl is
+// streamed into the cache folder. Importing the same archive again only hashes the file.
+class FuncArchiveIndex
+{
+public:
+    static FuncArchiveIndex &instance();
+
+    std::optional<FuncArchiveEntry> load(const QString &zipPath);
+    QDir cacheDir() const { return m_cacheDir; }
+
+private:
+    FuncArchiveIndex();
+    FuncArchiveIndex(const FuncArchiveIndex &) = delete;
+    FuncArchiveIndex &operator=(const FuncArchiveIndex &) = delete;
+
+    static QString archiveHash(const QString &zipPath);
+    std::optional<FuncArchiveEntry> extract(const QString &zipPath, const QString &hash) const;
+    void readIndex();
+    void writeIndex() const;
+
+    QDir m_cacheDir;
+    std::unordered_map<QString, FuncArchiveEntry> m_entries;
+    std::mutex m_mutex;
+};
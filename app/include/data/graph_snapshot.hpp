@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <QtNodes/Definitions>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class FdfBlockModel;
+
+// Copy of a block taken on the GUI thread, holds everything the engines read from a block
+struct SnapshotNode
+{
+    // set for the io blocks that have an entry in the kedro data catalog
+    struct CatalogEntry
+    {
+        QString name;
+        QString fileType;
+        QString fileName;
+        // file copied into the kedro project, data sources are relative to the tab data dir
+        QString sourcePath;
+    };
+
+    QtNodes::NodeId id = QtNodes::InvalidNodeId;
+    int type = 0; // FdfBlockModel::FdfType
+    QString name;
+    QString typeName;
+    QString functionName;
+    QString caption;
+    QStringList problems; // empty when the block is valid
+    bool hasParameters = false;
+    std::vector<std::pair<QString, QString>> parameters; // sorted by key
+    QStringList inputs;  // dataset names of the connected in ports
+    QStringList outputs; // dataset names of the out ports
+    std::optional<CatalogEntry> catalog;
+
+    static SnapshotNode fromBlock(const QtNodes::NodeId &id, const FdfBlockModel &block);
+};
+
+// Immutable view of a CustomGraph that can be handed to worker threads.
+// Nodes are stored in a table indexed by position, edges in compressed sparse row form.
+class GraphSnapshot
+{
+public:
+    using Index = uint32_t;
+    struct Edge
+    {
+        Index node; // the other end of the connection
+        QtNodes::PortIndex outPort;
+        QtNodes::PortIndex inPort;
+    };
+    struct EdgeRange
+    {
+        const Edge *first;
+        const Edge *last;
+        const Edge *begin() const { return first; }
+        const Edge *end() const { return last; }
+        size_t size() const { return last - first; }
+    };
+
+    // connected is maintained by the graph, it is not recomputed from the edges
+    GraphSnapshot(std::vector<std::shared_ptr<const SnapshotNode>> nodes,
+                  const std::vector<QtNodes::ConnectionId> &connections,
+                  bool connected);
+
+    size_t size() const { return m_nodes.size(); }
+    bool isEmpty() const { return m_nodes.empty(); }
+    const SnapshotNode &node(Index index) const { return *m_nodes[index]; }
+    std::optional<Index> indexOf(const QtNodes::NodeId &id) const;
+    EdgeRange successors(Index index) const;
+    EdgeRange predecessors(Index index) const;
+    // kahn order, ties are broken by position in the node table
+    const std::vector<Index> &topologicalOrder() const { return m_topologicalOrder; }
+    // longest distance from a block without inputs
+    int level(Index index) const { return m_levels[index]; }
+    // whether the included blocks are connected by the edges between them, the whole graph when
+    // included is empty
+    bool isConnected(const std::vector<bool> &included = {}) const;
+    // connectivity and block problems, prefixed with the block caption. With included, only
+    // those blocks are checked.
+    QStringList problems(const std::vector<bool> &included = {}) const;
+
+private:
+    void buildOrder();
+
+    std::vector<std::shared_ptr<const SnapshotNode>> m_nodes;
+    std::unordered_map<QtNodes::NodeId, Index> m_indices;
+    std::vector<Index> m_outOffsets;
+    std::vector<Edge> m_outEdges;
+    std::vector<Index> m_inOffsets;
+    std::vector<Edge> m_inEdges;
+    std::vector<Index> m_topologicalOrder;
+    std::vector<int> m_levels;
+    bool m_connected = false;
+};
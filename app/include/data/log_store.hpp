@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QTemporaryFile>
+#include <QtMessageHandler>
+
+#include <vector>
+
+// Append only line store for the log views. The text lives in a temporary file that is
+// memory mapped for reading, only the line offsets and severities are kept in memory. The file
+// is grown ahead of the text so appends rarely need a new map.
+class LogStore
+{
+public:
+    LogStore();
+    ~LogStore();
+    LogStore(const LogStore &) = delete;
+    LogStore &operator=(const LogStore &) = delete;
+
+    // splits the text into lines, returns the number of lines added
+    size_t append(const QString &text, const QtMsgType &type);
+    size_t size() const { return m_types.size(); }
+    QString line(size_t index) const;
+    QtMsgType type(size_t index) const { return QtMsgType(m_types[index]); }
+    // ascii case insensitive, needle is utf-8
+    bool contains(size_t index, const QByteArray &needle) const;
+    void clear();
+
+private:
+    QLatin1String bytes(size_t index) const;
+    void remap() const;
+
+    mutable QTemporaryFile m_file;
+    // used when the temporary file cannot be created
+    QByteArray m_memory;
+    mutable uchar *m_map = nullptr;
+    mutable qint64 m_mappedSize = 0;
+    mutable qint64 m_flushedSize = 0;
+    qint64 m_capacity = 0; // size of the file, the text may end before
+    mutable bool m_mapFailed = false;
+    // start of every line plus the end of the last one, lines end with '\n'
+    std::vector<qint64> m_offsets;
+    std::vector<quint8> m_types;
+};
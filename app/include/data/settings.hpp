@@ -1,20 +1,41 @@
 #pragma once
 
 #include <QObject>
-#include <QSettings>
+#include <QThreadPool>
 #include <QVariant>
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <mutex>
 
 namespace data {
+// Reads go to an immutable snapshot of all settings that is swapped atomically on every write,
+// so they never wait on QSettings. Writes are persisted on a background thread.
 class Settings : public QObject
 {
     Q_OBJECT
 public:
+    using Snapshot = std::map<QString, QVariant>;
+
     static Settings &instance();
 
+    // called from any thread
     void setValue(const QString &key, const QVariant &value);
     QVariant value(const QString &key) const;
+    template<typename T>
+    T get(const QString &key) const
+    {
+        return value(key).value<T>();
+    }
+    // hold on to it to read several settings that are consistent with each other
+    std::shared_ptr<const Snapshot> snapshot() const;
+    // callback runs in the thread of context, until the context is destroyed
+    QMetaObject::Connection subscribe(const QString &key,
+                                      const QObject *context,
+                                      std::function<void(const QVariant &)> callback);
+    // blocks until the writes so far are persisted
+    void flush();
     // for testing purposes
     void printAll() const;
 
@@ -26,8 +47,11 @@ private:
     ~Settings();
     Settings(const Settings &) = delete;
     Settings &operator=(const Settings &) = delete;
+    void persist();
 
-    QSettings m_settings;
-    mutable std::mutex m_mutex;
+    std::shared_ptr<const Snapshot> m_snapshot; // accessed with std::atomic_load/store
+    std::mutex m_writeMutex;                    // serializes writers, readers never take it
+    Snapshot m_unpersisted;                     // guarded by m_writeMutex
+    QThreadPool m_persistPool;
 };
-} // namespace data
\ No newline at end of file
+} // namespace data
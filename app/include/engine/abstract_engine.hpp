@@ -6,18 +6,32 @@
 
 #include <QtNodes/Definitions>
 
+#include <vector>
+
 class TabComponents;
 
+struct RunOptions
+{
+    // run only these blocks and the blocks they read from, what every sink needs when empty
+    std::vector<QtNodes::NodeId> targets;
+    // on a sample of the data, the results are marked as a preview
+    bool preview = false;
+};
+
 class AbstractEngine : public QObject
 {
     Q_OBJECT
 public:
     virtual ~AbstractEngine() {}
-    virtual bool execute(std::shared_ptr<TabComponents> tab) = 0;
+    virtual bool execute(std::shared_ptr<TabComponents> tab,
+                         const RunOptions &options = RunOptions())
+        = 0;
     QString getExecutionError() const { return m_executionError; }
 
     virtual bool validityCheck(std::shared_ptr<TabComponents> tab) = 0;
     QStringList getValidityWarnings() const { return m_validityWarnings; }
+    // chrome trace events written by the engine processes while tracing, one json object a line
+    virtual QStringList traceEventFiles() const { return QStringList(); }
 
 signals:
     void started();
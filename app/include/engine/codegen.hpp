@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QStringList>
+
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "data/graph_snapshot.hpp"
+
+// Passes over a graph snapshot that shape the generated pipeline, the graph itself is unchanged
+namespace codegen {
+
+using Chain = std::vector<GraphSnapshot::Index>; // in run order
+
+// a run on a sample of the data, for a quick check of the graph
+struct Preview
+{
+    int rows = 0;    // sampled from each csv data source
+    int maxIter = 0; // caps the iterations of the trainers
+    quint32 seed = 0;
+};
+
+// what is generated for a run
+struct Plan
+{
+    std::vector<bool> included; // by snapshot index, empty when every block is included
+    // by snapshot index, the block whose results are used instead. Empty when nothing is merged.
+    std::vector<GraphSnapshot::Index> sameAs;
+    std::unordered_map<QString, QString> aliases; // dataset of a merged block -> dataset used
+    std::vector<Chain> fused;
+    std::optional<Preview> preview;
+
+    bool includes(GraphSnapshot::Index index) const
+    {
+        return included.empty() || included[index];
+    }
+    GraphSnapshot::Index resultOf(GraphSnapshot::Index index) const
+    {
+        return sameAs.empty() ? index : sameAs[index];
+    }
+    // the included blocks and the merged ones, they are all part of what the user runs and
+    // their readers are only connected through them
+    std::vector<bool> requested() const
+    {
+        std::vector<bool> result = included;
+        for (GraphSnapshot::Index i = 0; i < sameAs.size(); ++i)
+            if (sameAs[i] != i)
+                result[i] = true;
+        return result;
+    }
+};
+
+// data and output blocks are catalog entries, every other block is a pipeline node
+bool isPipelineNode(const SnapshotNode &node);
+// blocks whose results are shown or saved, a run exists to update them
+bool isSink(const SnapshotNode &node);
+std::vector<GraphSnapshot::Index> sinks(const GraphSnapshot &snapshot);
+
+// the targets and every block they read from, directly or not
+std::vector<bool> upstreamClosure(const GraphSnapshot &snapshot,
+                                  const std::vector<GraphSnapshot::Index> &targets);
+
+// Leaves out the blocks that compute the same as an earlier block: same type, function,
+// parameters and inputs. Their readers use the results of the earlier block instead. Sinks and
+// blocks feeding an output block are kept. Returns the merged blocks with the block kept.
+std::vector<std::pair<GraphSnapshot::Index, GraphSnapshot::Index>> mergeDuplicates(
+    const GraphSnapshot &snapshot, Plan &plan);
+
+// Linear runs of included pipeline nodes where every block but the last sends all of its outputs
+// to the next block only, so nothing else reads the datasets inside a run. Runs have at least two
+// blocks and are ordered like the topological order of their first block.
+std::vector<Chain> fusableChains(const GraphSnapshot &snapshot, const Plan &plan = Plan());
+
+// "a -> b -> c"
+QString describe(const GraphSnapshot &snapshot, const Chain &chain);
+
+} // namespace codegen
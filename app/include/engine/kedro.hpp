@@ -1,12 +1,17 @@
 #pragma once
 
 #include "abstract_engine.hpp"
+#include "codegen.hpp"
+#include "run_cache.hpp"
 
 #include <QProcess>
 #include <QTemporaryDir>
 #include <QTimer>
 
+#include <optional>
+
 class CustomGraph;
+class GraphSnapshot;
 
 class Kedro : public AbstractEngine
 {
@@ -14,20 +19,47 @@ class Kedro : public AbstractEngine
 public:
     Kedro();
     ~Kedro();
-    virtual bool execute(std::shared_ptr<TabComponents> tab) override;
+    virtual bool execute(std::shared_ptr<TabComponents> tab,
+                         const RunOptions &options = RunOptions()) override;
     virtual bool validityCheck(std::shared_ptr<TabComponents> tab) override;
+    virtual QStringList traceEventFiles() const override;
     QDir initWorkspace(std::shared_ptr<TabComponents> tab);
+    // content of the generated files for the blocks of the plan, only reads the snapshot so it
+    // can run on any thread
+    static QString serializeParameters(const GraphSnapshot &snapshot,
+                                       const codegen::Plan &plan = codegen::Plan());
+    // the blocks of each fused chain run as a single kedro node
+    static QString serializePipeline(const GraphSnapshot &snapshot,
+                                     const codegen::Plan &plan = codegen::Plan());
+    static QString serializeCatalog(const GraphSnapshot &snapshot,
+                                    const codegen::Plan &plan = codegen::Plan());
 
 private slots:
     void onExecutionFinished(int exitCode, QProcess::ExitStatus exitStatus);
     void onTimeOut();
+    void onCachedRun();
 
 private:
-    QString serializeNode(const QtNodes::NodeId &id, CustomGraph *graph) const;
     void verifySetup();
-    bool generateParametersYml(const QDir &kedroProject, CustomGraph *graph);
-    bool generateCatalogYml(const QDir &kedroProject, std::shared_ptr<TabComponents> tab);
-    bool generatePipelinePy(const QDir &kedroProject, CustomGraph *graph);
+    void startRun();
+    // the blocks the run needs and how they are generated, nullopt when there is nothing to run
+    std::optional<codegen::Plan> makePlan(const GraphSnapshot &snapshot, const RunOptions &options);
+    bool validityCheck(const GraphSnapshot &snapshot, const codegen::Plan &plan);
+    // empty when an input cannot be read, the run is not cached then
+    QString runFingerprint(std::shared_ptr<TabComponents> tab,
+                           const GraphSnapshot &snapshot,
+                           const codegen::Plan &plan) const;
+    static QStringList runOutputs(const GraphSnapshot &snapshot, const codegen::Plan &plan);
+    bool generateParametersYml(const QDir &kedroProject,
+                               const GraphSnapshot &snapshot,
+                               const codegen::Plan &plan);
+    bool generateCatalogYml(const QDir &kedroProject,
+                            std::shared_ptr<TabComponents> tab,
+                            const GraphSnapshot &snapshot,
+                            const codegen::Plan &plan);
+    bool generatePipelinePy(const QDir &kedroProject,
+                            const GraphSnapshot &snapshot,
+                            const codegen::Plan &plan);
     QDir ensureDirExists(const QString &path);
     void postExecutionProcess();
     void postScoreModel(CustomGraph *graph, const QtNodes::NodeId &id);
@@ -40,13 +72,20 @@ private:
     const QString m_PYTHON_EXECUTABLE;
     const QDir m_KEDRO_UMBRELLA_DIR;
     QTemporaryDir m_runtimeCache;
+    RunCache m_runCache;
+    const QString m_ENGINE_VERSION;
     struct ExecutionBundle
     {
         bool inProgress = false;
         QTimer timer;
         QProcess process;
         QDir project;
+        qint64 traceStart = -1; // start of the kedro process while tracing
         std::shared_ptr<TabComponents> tab;
+        std::shared_ptr<const GraphSnapshot> snapshot; // graph as it was executed
+        codegen::Plan plan;
+        QString runKey;      // run cache entry, empty when the run is not cached
+        QStringList outputs; // project relative paths of the results
     };
     std::unique_ptr<ExecutionBundle> m_execution;
     const QString m_DEFAULT_TEMPLATE;
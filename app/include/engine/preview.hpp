@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QString>
+
+// Preview runs read a sample of the data so a graph can be checked quickly
+namespace preview {
+
+// Writes the header and rows of the csv source picked with the seed, in their original order.
+// The same seed picks the same rows on every platform. All rows are kept when there are not
+// more than rows of them.
+bool sampleCsv(const QString &source, const QString &destination, int rows, quint32 seed);
+
+} // namespace preview
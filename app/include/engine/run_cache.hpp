@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QString>
+#include <QStringList>
+
+// Outputs of earlier runs, kept across sessions and shared by every builder instance of the user.
+// An entry is a copy of the output files of a run, keyed by a fingerprint of everything the run
+// reads. Entries are written and read under a file lock so concurrent instances never see a
+// partial entry. Storing an entry evicts the least recently used ones past the size and age caps.
+class RunCache
+{
+public:
+    static constexpr qint64 DEFAULT_MAX_BYTES = qint64(2) << 30;
+    static constexpr int DEFAULT_MAX_AGE_DAYS = 30;
+
+    // hashes the inputs of a run in the order they are added
+    class Fingerprint
+    {
+    public:
+        Fingerprint();
+        void add(const QString &label, const QByteArray &data);
+        // false when the file cannot be read, the fingerprint should not be used then
+        bool addFile(const QString &label, const QString &path);
+        QString result() const;
+
+    private:
+        QCryptographicHash m_hash;
+    };
+
+    explicit RunCache(const QString &root = defaultRoot(),
+                      qint64 maxBytes = DEFAULT_MAX_BYTES,
+                      int maxAgeDays = DEFAULT_MAX_AGE_DAYS);
+    static QString defaultRoot();
+    QString root() const { return m_root.absolutePath(); }
+
+    bool contains(const QString &key) const;
+    // copies the cached outputs over the same paths in the project, paths are relative to it
+    bool restore(const QString &key, const QDir &project, const QStringList &paths) const;
+    // outputs missing from the project are left out of the entry
+    bool store(const QString &key, const QDir &project, const QStringList &paths);
+    // removes the entries unused for longer than the age cap, then the least recently used ones
+    // until the rest fit in the size cap. Entries in use by another instance are kept.
+    void evict(const QString &keep = QString());
+
+private:
+    QString entryPath(const QString &key) const;
+    QString lockPath(const QString &key) const;
+    QString usedPath(const QString &key) const;
+    void markUsed(const QString &key) const;
+
+    const QDir m_root;
+    const qint64 m_maxBytes;
+    const int m_maxAgeDays;
+};
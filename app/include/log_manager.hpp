@@ -3,10 +3,21 @@
 #include <QObject>
 #include <QtMessageHandler>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <QtUtility/data/mpsc_ring_buffer.hpp>
 #include <QtUtility/data/qsingleton.hpp>
 
 #include "ui/log_panel.hpp"
 
+class QTimer;
+
+// Messages are queued without locking by the thread that logs them. A writer thread appends
+// them to the log file and stderr, the log panels receive them in batches on the GUI thread.
 class LogManager : public QSingleton<LogManager>
 {
     Q_OBJECT
@@ -16,17 +27,43 @@ public:
     ~LogManager() override;
     void init();
     void registerLogPanel(LogPanel *panel);
+    // called from any thread, fatal messages are written before returning
+    void post(const QtMsgType &type, const QString &message);
 
 public slots:
     void appendMessage(const QString &message, const QtMsgType &type = QtInfoMsg);
 
+private slots:
+    void deliver();
+
 private:
-    QtMessageHandler m_originalHandler;
-    QVector<LogPanel *> m_logPanels;
-    struct LogMessage
+    LogManager();
+    struct LogEntry
     {
-        QString string;
-        QColor color;
+        QtMsgType type = QtInfoMsg;
+        QString message;
     };
-    std::vector<LogMessage> m_notPrinted;
-};
\ No newline at end of file
+    void startWriter();
+    // drains the queue and joins the writer, later messages are written synchronously
+    void stopWriter();
+    void writerLoop();
+    void queueDelivery(std::vector<LogPanel::Message> &batch);
+    void writeNow(const QString &message);
+
+    QtMessageHandler m_originalHandler;
+    QVector<LogPanel *> m_logPanels;
+    // messages logged before a panel was registered, oldest are dropped
+    std::deque<LogPanel::Message> m_notPrinted;
+
+    QtUtility::data::MpscRingBuffer<LogEntry> m_queue;
+    std::atomic<size_t> m_dropped;
+    std::atomic<bool> m_running;
+    std::thread m_writer;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+
+    // written by the writer, taken by the GUI thread once per frame
+    std::mutex m_deliveryMutex;
+    std::deque<LogPanel::Message> m_delivery;
+    QTimer *m_deliveryTimer;
+};
@@ -6,7 +6,7 @@
 
 class QStackedWidget;
 class QPushButton;
-class QPlainTextEdit;
+class OutputPanel;
 
 class BottomPanel : public QDockWidget
 {
@@ -24,8 +24,8 @@ private:
         QString title;
         QPushButton *button;
         uint counter;
-        QPlainTextEdit *widget;
+        QWidget *widget;
     };
     std::vector<Panel> m_panels;
-    QPlainTextEdit *m_outputPanel;
+    OutputPanel *m_outputPanel;
 };
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QObject>
+
+#include <QtNodes/Definitions>
+
+#include <unordered_set>
+
+namespace QtNodes {
+class GraphicsView;
+} // namespace QtNodes
+
+class CustomGraph;
+
+// Switches the blocks of a scene between full detail and a cheap overview when zooming out.
+// Below the threshold the embedded widgets are hidden and the blocks are drawn from a pixmap
+// cached at item resolution, so zooming and panning don't repaint every block.
+class LevelOfDetail : public QObject
+{
+    Q_OBJECT
+public:
+    LevelOfDetail(CustomGraph *graph, QtNodes::GraphicsView *view);
+    bool isDetailed() const { return m_detailed; }
+
+private slots:
+    void onScaleChanged(double scale);
+
+private:
+    void apply(QtNodes::NodeId id);
+
+    CustomGraph *m_graph;
+    QtNodes::GraphicsView *m_view;
+    // the blocks of the graph, a threshold crossing styles them without walking the scene
+    std::unordered_set<QtNodes::NodeId> m_nodes;
+    bool m_detailed = true;
+};
@@ -1,16 +1,15 @@
 #pragma once
 
-#include <QColor>
-#include <QPlainTextEdit>
+#include "ui/log_view.hpp"
 
-class LogPanel : public QPlainTextEdit
+class LogPanel : public LogView
 {
     Q_OBJECT
 public:
-    LogPanel(QWidget *parent = nullptr);
+    using Message = LogModel::Line;
 
-    void appendMessage(const QString &text, const QColor &color = QColor());
+    LogPanel(QWidget *parent = nullptr);
 
-private:
-    const QColor m_DEFAULT_TEXT_COLOR;
-};
\ No newline at end of file
+    void appendMessage(const QString &text, const QtMsgType &type = QtInfoMsg);
+    void appendMessages(const std::vector<Message> &messages);
+};
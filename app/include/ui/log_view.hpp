@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QAbstractListModel>
+#include <QWidget>
+#include <QtMessageHandler>
+
+#include <vector>
+
+#include "data/log_store.hpp"
+
+class QComboBox;
+class QLineEdit;
+class QTableView;
+
+// List model over a LogStore. When a filter is set only the matching lines are indexed,
+// appends are checked against the filter so the model never rescans the whole store for them.
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    struct Line
+    {
+        QString text;
+        QtMsgType type = QtInfoMsg;
+    };
+
+    explicit LogModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void append(const std::vector<Line> &lines);
+    // lines less severe than minimumType are hidden, text is matched case insensitively
+    void setFilter(const QString &text, const QtMsgType &minimumType);
+    // next row containing text after from, wraps around, -1 when nothing matches
+    int find(const QString &text, int from, bool backward) const;
+    void clear();
+
+private:
+    bool accepted(size_t line) const;
+    size_t lineAt(int row) const { return m_filtered ? m_rows[row] : size_t(row); }
+
+    LogStore m_store;
+    bool m_filtered = false;
+    size_t m_shown = 0; // store lines known to the view when not filtered
+    std::vector<quint32> m_rows; // store lines shown when filtered
+    QByteArray m_filterText;
+    int m_minimumSeverity = 0;
+};
+
+// Filter, search and a virtualized list, only the visible lines are read from the store
+class LogView : public QWidget
+{
+    Q_OBJECT
+public:
+    LogView(QWidget *parent = nullptr);
+
+    void appendLines(const std::vector<LogModel::Line> &lines);
+    void clear();
+
+private:
+    void applyFilter();
+    void search(bool backward);
+
+    LogModel *m_model;
+    QTableView *m_view;
+    QLineEdit *m_filterEdit;
+    QComboBox *m_typeBox;
+    QLineEdit *m_searchEdit;
+};
@@ -8,7 +8,9 @@ class TabManager;
 class BlockManager;
 class QAction;
 class Temp;
+class Blocks;
 class TabComponents;
+struct RunOptions;
 
 class MainWindow : public QMainWindow
 {
@@ -21,6 +23,9 @@ public:
     bool openDCB(const QString &fileName);
     bool executeDCB();
     std::shared_ptr<TabManager> getTabManager() const { return m_tabManager; }
+    // starts a new trace session, stop it with writeTrace
+    void startTrace();
+    bool writeTrace(const QString &path);
 
 public slots:
     void gridToggled(bool enabled);
@@ -42,6 +47,7 @@ private:
     void initPrimarySideBar();
     void initLogPanel();
     bool validateTab(std::shared_ptr<TabComponents> &tab);
+    bool execute(const RunOptions &options);
     void scoreParameters(const QString &scorePath);
     void executionFinished(bool success);
 
@@ -51,6 +57,7 @@ private:
     GraphicsSceneTabWidget *m_graphicsSceneTabWidget;
     QWidget *m_centralWidget;
     std::unordered_map<SideBarAction, QAction *> m_sidebarActions;
+    Blocks *m_blocks = nullptr;
 
     // Logic
     std::unique_ptr<AbstractEngine> m_engine;
@@ -12,6 +12,8 @@ using QtNodes::PortType;
 
 #include "ui/models/nodes.hpp"
 
+class CustomGraph;
+
 class FdfBlockModel : public NodeDelegateModel
 {
     Q_OBJECT
@@ -56,13 +58,22 @@ public:
                                  const QString &annot);
     bool resetPortCaption(PortType portType, PortIndex portIndex);
     void propagateUpdate();
-    virtual bool checkBlockValidity() const;
+    // set by the graph the block is created in, used to defer propagation in graph updates
+    void setGraph(CustomGraph *graph, const QtNodes::NodeId &nodeId);
+    // all the reasons the block cannot be executed, empty when it is valid
+    virtual QStringList validityProblems() const;
+    bool checkBlockValidity() const { return validityProblems().isEmpty(); }
+    // shows the problems on the canvas, set by the graph when they change
+    void setValidityProblems(const QStringList &problems);
+    QStringList shownValidityProblems() const { return m_validityProblems; }
 
     virtual std::shared_ptr<NodeData> inData(PortIndex const index);
     virtual std::unordered_map<QString, QString> getParameters() const;
     virtual std::unordered_map<QString, QMetaType::Type> getParameterSchema() const;
     virtual QStringList getParameterOptions(const QString &key) const;
     virtual void setParameter(const QString &key, const QString &value);
+    // user edit of a parameter, notifies the graph
+    void updateParameter(const QString &key, const QString &value);
     uint nPorts(const PortType &portType, const QString &typeId) const;
     virtual uint minModifiablePorts(const PortType &portType, const QString &typeId) const;
     virtual bool portNumberModifiable(const PortType &portType) const { return false; };
@@ -71,6 +82,9 @@ public:
     void setExecutedValues(const std::unordered_map<QString, QString> &values);
     QStringList getExecutedGraphs() const { return m_executedGraphs; }
     void setExecutedGraphs(const QStringList &paths);
+    // the results are of a run on sampled data
+    bool isExecutedPreview() const { return m_executedPreview; }
+    void setExecutedPreview(bool preview);
     virtual bool canConnect(ConnectionInfo &connInfo) const;
 
     template<typename T>
@@ -90,6 +104,7 @@ signals:
     void outPortInserted(const PortIndex &index);
     void outPortDeleted(const PortIndex &index);
     void inPortInserted(const PortIndex &index);
+    void parameterUpdated(const QString &key);
 
 public slots:
     virtual void outputConnectionCreated(ConnectionId const &conn) override;
@@ -241,5 +256,10 @@ private:
     OutPortType m_outPorts;
     std::unordered_map<QString, QString> m_executedValues;
     QStringList m_executedGraphs;
+    bool m_executedPreview = false;
     QPointer<QLabel> m_label; // For block resize
+    QStringList m_validityProblems;
+    QColor m_boundaryColor;
+    CustomGraph *m_graph = nullptr;
+    QtNodes::NodeId m_nodeId = QtNodes::InvalidNodeId;
 };
@@ -27,7 +27,7 @@ public:
     void setFile(const QFileInfo &file);
     static QString fileFilter();
     QString outPortCaption();
-    bool checkBlockValidity() const override;
+    QStringList validityProblems() const override;
 
 signals:
     void importClicked();
@@ -54,7 +54,7 @@ public:
     QFileInfo file() const { return m_file; }
     QString fileTypeString() const;
     QString getFileName() const;
-    bool checkBlockValidity() const override;
+    QStringList validityProblems() const override;
 
 signals:
     void importClicked();
@@ -115,6 +115,6 @@ public:
 private:
     void updateGraph();
 
-    QLabel *m_graph;
+    QPointer<QLabel> m_graph;
     QFileInfo m_file;
 };
\ No newline at end of file
@@ -30,6 +30,10 @@ public:
 protected:
     QString m_defaultName;
     NodeDataType m_type;
+    // types of the tab the port was created in, which owns the block. Later reads must not
+    // follow the current tab, it may have changed by then. Never null, without a tab the tab
+    // manager hands out a throw-away manager.
+    UIDManager *m_uidManager = TabManager::getUIDManager();
 };
 
 class DataNode : public NamedNode
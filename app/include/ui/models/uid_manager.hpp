@@ -1,6 +1,9 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <QString>
 #include <QtNodes/Definitions>
 #include <QtNodes/DirectedAcyclicGraphModel>
@@ -87,17 +90,46 @@ public:
     QString getUniqueTag(QString tag);
     QString toString(const std::vector<FdfUID> &ids) const;
     FdfUID getOrCreateUIDOnFuncLoad(const QString &fileHash, int originalId);
+    // canonical representative of the type, after the overrides
+    FdfUID resolve(FdfUID uid) const;
+    bool undoLastOverride();
 
 private:
+    struct Override
+    {
+        FdfUID removeId;
+        FdfUID keepId;
+        QString tag;        // tag of the removed type, restored on undo
+        size_t journalSize; // the changes made since are undone with the override
+    };
+    using Table = std::unordered_map<FdfUID, int> UIDManager::*;
+    struct Change
+    {
+        Table table;
+        FdfUID key;
+        std::optional<int> value; // before the change, none when the entry did not exist
+    };
+
     CustomGraph *graph = nullptr;
+    FdfUID lastUid = NONE_ID;
     // The maps from type id to human-readable tag (one-to-one, both are unique)
+    // only canonical types are in the maps
     std::map<FdfUID, QString> uidToTag = {{NONE_ID, NONE_TAG}};
     std::map<QString, FdfUID> tagToUid = {{NONE_TAG, NONE_ID}};
-    // Helper functions to override and display the map
-    void overrideType(FdfUID removeType, FdfUID keepType);
-    bool replaceTypesInUIDVector(std::vector<FdfUID> &vec, FdfUID keepType, FdfUID removeType);
+    // Type equality as union-find, by rank with path compression. Roots have no parent and
+    // rank 0 is not stored. The canonical type of a set is its root unless listed.
+    std::unordered_map<FdfUID, FdfUID> parent;
+    std::unordered_map<FdfUID, int> rank;
+    std::unordered_map<FdfUID, FdfUID> canonical; // root -> type that keeps the tag
+    std::vector<Override> overrides;
+    std::vector<Change> journal; // every write to the tables above, undone last first
+    void write(Table table, FdfUID key, std::optional<int> value);
+    FdfUID root(FdfUID uid) const; // no compression, readers may share the manager
+    FdfUID find(FdfUID uid);       // compresses the path to the root
+    void unite(FdfUID removeId, FdfUID keepId);
+    // Helper functions to refresh the ports of the given nodes and display the map
+    void refreshTypes(const std::vector<NodeId> &nodes);
     void displayMaps() const;
-    void refreshDisplayNames();
     // Cache of UID used to load/save functions
     // It allows to remap stored UIDs to runtime UIDs and ensure
     // that UIDs from the same file are mapped to same runtime UID.
@@ -1,10 +1,13 @@
 #pragma once
 
-#include <QPlainTextEdit>
+#include "ui/log_view.hpp"
 
-class OutputPanel : public QPlainTextEdit
+class OutputPanel : public LogView
 {
     Q_OBJECT
 public:
     OutputPanel(QWidget *parent = nullptr);
+
+    // engine output, the severity of each line is taken from its log level
+    void appendText(const QString &text);
 };
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "ui/models/uid_manager.hpp"
+#include <functional>
+#include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <QObject>
+#include <QPointer>
 #include <QTableWidgetItem>
 #include <QWidget>
 #include <QtNodes/NodeDelegateModel>
@@ -13,7 +17,9 @@ class QLineEdit;
 class QSpinBox;
 class QStackedWidget;
 class QFormLayout;
+class QTimer;
 class BlockManager;
+class CustomGraph;
 class TabManager;
 class FdfBlockModel;
 using QtNodes::PortType;
@@ -34,9 +40,13 @@ public:
     Blocks(std::shared_ptr<BlockManager> blockManager,
            std::shared_ptr<TabManager> tabManager,
            QWidget *parent = nullptr);
+    ~Blocks();
 
     QtNodes::NodeId nodeId() const { return m_nodeId; }
     void setNodeId(QtNodes::NodeId id);
+    // applies the parameter edits still waiting for the user to pause, call it before the graph
+    // is saved or run
+    void flushParameters();
 
 signals:
     void nodeIdChanged(QtNodes::NodeId id);
@@ -47,14 +57,33 @@ private slots:
     void onNodeUpdated(QtNodes::NodeId id);
 
 private:
+    // value accessors of one parameter row, setValue does not emit the edit signals
+    struct ParameterField
+    {
+        std::function<bool(const QString &)> shows;
+        std::function<void(const QString &)> setValue;
+    };
+    // parameter rows of one block type, reused and patched while blocks of that type are selected
+    struct ParameterEditor
+    {
+        QWidget *widget = nullptr;
+        std::unordered_map<QString, ParameterField> fields;
+    };
+
     void initUi();
     void initGlobals();
     void initEditor();
     void initLibrary();
     void blockEditorSignals(bool value);
     void enableEditorWidgets(bool value);
-    QWidget *generateParameterWidget(FdfBlockModel *block);
-    QWidget *generatePortsWidget(FdfBlockModel *block);
+    ParameterEditor createParameterEditor(FdfBlockModel *block);
+    void updateParameterWidget(FdfBlockModel *block);
+    void updatePortsWidget(FdfBlockModel *block);
+    void fillPortItem(QTableWidgetItem *item,
+                      FdfBlockModel *block,
+                      int row,
+                      int col,
+                      UIDManager *uidManager);
     void handlePortEdit(FdfBlockModel *block,
                         QTableWidget *tableWidget,
                         QTableWidgetItem *item,
@@ -62,6 +91,7 @@ private:
                         const QVector<int> &visibleCols);
     void handleInputRows(FdfBlockModel *block);
     void setupCaptionValidation();
+    void queueParameter(const QString &key, const QString &value);
 
     std::shared_ptr<BlockManager> m_blockManager;
     std::shared_ptr<TabManager> m_tabManager;
@@ -81,6 +111,15 @@ private:
     QSpinBox *m_trainerInputEdit;
     QSpinBox *m_trainerOutputEdit;
     QStackedWidget *m_parametersWidget;
+    // keyed by block name and parameter keys
+    std::unordered_map<QString, ParameterEditor> m_parameterEditors;
+    QTableWidget *m_portsTable;
+    QVector<int> m_portColumns;
+    // parameter edits are applied once the user pauses
+    QTimer *m_parameterTimer;
+    QPointer<CustomGraph> m_pendingGraph;
+    QtNodes::NodeId m_pendingNodeId;
+    std::map<QString, QString> m_pendingParameters;
     QtUtility::widgets::QCollapsibleWidget *m_library;
     QtUtility::widgets::QCollapsibleWidget *m_globals;
     QSpinBox *m_randomStateSpinBox;
@@ -2,6 +2,7 @@
 
 #include <QWidget>
 
+class QCheckBox;
 class QComboBox;
 class QSpinBox;
 class MainWindow;
@@ -20,5 +21,9 @@ private:
     QComboBox *m_formatBox;
     QComboBox *m_engineBox;
     QSpinBox *m_engineTimeoutBox;
+    QCheckBox *m_runCacheBox;
+    QCheckBox *m_fusionBox;
+    QSpinBox *m_previewRowsBox;
+    QSpinBox *m_previewIterationsBox;
     MainWindow *mainWindowPtr;
 };
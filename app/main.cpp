@@ -1,12 +1,22 @@
 #include "log_manager.hpp"
 #include "ui/main_window.hpp"
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QFile>
 
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption traceOption("trace",
+                                   "Record a chrome trace of the session into <file>.",
+                                   "file");
+    parser.addOption(traceOption);
+    parser.addPositionalArgument("dcb", "DCB file to open.", "[dcb]");
+    parser.process(app);
+
     //QApplication::setStyle(QStyleFactory::create("Fusion"));
 
     { // load stylesheet
@@ -19,11 +29,18 @@ int main(int argc, char *argv[])
     LogManager::instance().init();
 
     MainWindow w;
+    if (parser.isSet(traceOption)) {
+        w.startTrace();
+        QString tracePath = parser.value(traceOption);
+        QObject::connect(&app, &QApplication::aboutToQuit, &w, [&w, tracePath]() {
+            w.writeTrace(tracePath);
+        });
+    }
     w.show();
 
     // User can specify a DCB file while running the executable
-    if (argc > 1) {
-        QString dcbFile = argv[1];
+    if (!parser.positionalArguments().isEmpty()) {
+        QString dcbFile = parser.positionalArguments().first();
         w.openDCB(dcbFile);
     }
     return app.exec();
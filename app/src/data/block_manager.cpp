@@ -85,7 +85,7 @@ void BlockManager::onTabCreated(QWidget *view)
         connect(tab->getGraph(),
                 &CustomGraph::nodePositionUpdated,
                 this,
-                &BlockManager::nodeUpdated);
+                &BlockManager::nodePositionUpdated);
         connect(tab->getGraph(), &CustomGraph::nodeUpdated, this, &BlockManager::nodeUpdated);
     }
 }
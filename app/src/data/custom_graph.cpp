@@ -9,30 +9,33 @@
 #include <QApplication>
 #include <QMessageBox>
 #include <QMetaObject>
+#include <QThread>
+#include <QtUtility/trace/trace.hpp>
+
+#include <algorithm>
 
 using QtNodes::NodeRole;
 using QtNodes::PortRole;
 namespace {
 
-template<typename MapType>
-void removeByValue(MapType &map, const typename MapType::mapped_type &valueToRemove)
-{
-    for (auto it = map.begin(); it != map.end();)
-        if (it->second == valueToRemove)
-            it = map.erase(it);
-        else
-            ++it;
-}
+constexpr int VALIDATION_DELAY_MSECS = 100;
 
+// returns base, or the first free "base_N" using the per-base counter so that repeated
+// copies of the same block don't probe every suffix already handed out
 template<typename MapType>
-void removeByPairFirst(MapType &map,
-                       const typename MapType::mapped_type::first_type &firstValueToRemove)
+QString allocateUnique(const QString &base,
+                       const MapType &used,
+                       std::unordered_map<QString, uint> &counters)
 {
-    for (auto it = map.begin(); it != map.end();)
-        if (it->second.first == firstValueToRemove)
-            it = map.erase(it);
-        else
-            ++it;
+    if (used.count(base) == 0)
+        return base;
+    uint &counter = counters[base];
+    counter = std::max(counter, 1u);
+    QString unique;
+    do
+        unique = QString("%1_%2").arg(base, QString::number(++counter));
+    while (used.count(unique) > 0);
+    return unique;
 }
 
 } // namespace
@@ -41,6 +44,22 @@ CustomGraph::CustomGraph(std::shared_ptr<QtNodes::NodeDelegateModelRegistry> reg
     : DirectedAcyclicGraphModel(registry)
 {
     connect(this, &CustomGraph::nodeDeleted, this, &CustomGraph::onNodeDeleted);
+    // resetting an input can change the signature of the outputs without propagating
+    connect(this, &CustomGraph::connectionCreated, this, [this](const QtNodes::ConnectionId &id) {
+        indexNodeTypes(id.inNodeId);
+        onBlockChanged(id.inNodeId);
+        if (!m_componentsStale)
+            uniteComponents(id.outNodeId, id.inNodeId);
+    });
+    connect(this, &CustomGraph::connectionDeleted, this, [this](const QtNodes::ConnectionId &id) {
+        indexNodeTypes(id.inNodeId);
+        onBlockChanged(id.inNodeId);
+        // a union-find cannot split, the components are rebuilt when next queried
+        m_componentsStale = true;
+    });
+    m_validationTimer.setSingleShot(true);
+    m_validationTimer.setInterval(VALIDATION_DELAY_MSECS);
+    connect(&m_validationTimer, &QTimer::timeout, this, &CustomGraph::revalidate);
 }
 
 std::vector<DataSourceModel *> CustomGraph::getDataSourceModels() const
@@ -87,14 +106,18 @@ bool CustomGraph::connectionPossible(QtNodes::ConnectionId const connectionId) c
 
 void CustomGraph::initBlockConnections(const QtNodes::NodeId nodeId, FdfBlockModel *block)
 {
+    block->setGraph(this, nodeId);
+    // while bulk loading, uniqueness is applied once in endBulkLoad
     connect(block, &FdfBlockModel::captionUpdated, this, [this, block, nodeId]() {
-        makeCaptionUnique(nodeId, block);
+        if (!m_bulkLoading)
+            makeCaptionUnique(nodeId, block);
     });
     connect(block,
             &FdfBlockModel::outPortCaptionUpdated,
             this,
             [this, block, nodeId](const PortIndex &index) {
-                makeOutPortsUnique(nodeId, block, index);
+                if (!m_bulkLoading)
+                    makeOutPortsUnique(nodeId, block, index);
             });
     connect(block, &FdfBlockModel::outPortInserted, this, [nodeId, this](const PortIndex index) {
         onOutPortInserted(nodeId, index);
@@ -104,7 +127,24 @@ void CustomGraph::initBlockConnections(const QtNodes::NodeId nodeId, FdfBlockMod
     });
     connect(block, &FdfBlockModel::outPortDeleted, this, [nodeId, this](const PortIndex index) {
         onOutPortDeleted(nodeId, index);
+        indexNodeTypes(nodeId);
+    });
+    // out port types are (re)assigned before the block propagates or updates its content
+    connect(block, &FdfBlockModel::dataUpdated, this, [nodeId, this]() { indexNodeTypes(nodeId); });
+    connect(block, &FdfBlockModel::contentUpdated, this, [nodeId, this]() {
+        indexNodeTypes(nodeId);
     });
+
+    // any change to the block makes its snapshot record stale
+    auto invalidate = [nodeId, this]() { onBlockChanged(nodeId); };
+    connect(block, &FdfBlockModel::captionUpdated, this, invalidate);
+    connect(block, &FdfBlockModel::outPortCaptionUpdated, this, invalidate);
+    connect(block, &FdfBlockModel::outPortInserted, this, invalidate);
+    connect(block, &FdfBlockModel::outPortDeleted, this, invalidate);
+    connect(block, &FdfBlockModel::inPortInserted, this, invalidate);
+    connect(block, &FdfBlockModel::parameterUpdated, this, invalidate);
+    connect(block, &FdfBlockModel::dataUpdated, this, invalidate);
+    connect(block, &FdfBlockModel::contentUpdated, this, invalidate);
 }
 
 void CustomGraph::onNodeCreated(const QtNodes::NodeId nodeId)
@@ -113,10 +153,26 @@ void CustomGraph::onNodeCreated(const QtNodes::NodeId nodeId)
     auto block = delegateModel<FdfBlockModel>(nodeId);
     if (!block)
         return;
+    // blocks created together, as by a paste, are propagated once when control is back in the
+    // event loop. Without a running loop, as in the tests, propagation stays immediate.
+    if (!m_bulkLoading && m_updateDepth == 0 && QThread::currentThread()->loopLevel() > 0) {
+        beginUpdate();
+        QMetaObject::invokeMethod(this, &CustomGraph::commitUpdate, Qt::QueuedConnection);
+    }
     initBlockConnections(nodeId, block);
-    makeCaptionUnique(nodeId, block);
-    makeOutPortsUnique(nodeId, block);
-    stylePorts(nodeId, block);
+    onBlockChanged(nodeId);
+    if (!m_componentsStale) {
+        m_componentParent[nodeId] = nodeId;
+        ++m_componentCount;
+    }
+    if (m_bulkLoading) {
+        m_bulkLoadedNodes.push_back(nodeId);
+    } else {
+        makeCaptionUnique(nodeId, block);
+        makeOutPortsUnique(nodeId, block);
+        stylePorts(nodeId, block);
+        indexNodeTypes(nodeId);
+    }
 
     if (block->name() == io_names::DATA_SOURCE) {
         m_dataSourceNodes.insert(nodeId);
@@ -135,6 +191,202 @@ void CustomGraph::onNodeCreated(const QtNodes::NodeId nodeId)
     }
 }
 
+void CustomGraph::beginBulkLoad()
+{
+    beginUpdate();
+    m_bulkLoading = true;
+    m_bulkLoadedNodes.clear();
+}
+
+void CustomGraph::endBulkLoad()
+{
+    if (!m_bulkLoading)
+        return;
+    m_bulkLoading = false;
+    QTUTILITY_TRACE_SCOPE("endBulkLoad");
+    std::vector<QtNodes::NodeId> loaded;
+    loaded.swap(m_bulkLoadedNodes);
+
+    for (const auto &nodeId : loaded) {
+        auto block = delegateModel<FdfBlockModel>(nodeId);
+        if (!block)
+            continue;
+        // type tags were restored without refreshing the ports sharing them
+        for (auto &dataPort : block->allOutData<DataNode>())
+            dataPort->updateDisplayName();
+        makeCaptionUnique(nodeId, block);
+        makeOutPortsUnique(nodeId, block, false);
+        stylePorts(nodeId, block);
+        indexNodeTypes(nodeId);
+    }
+
+    // every loaded block is marked dirty, the commit propagates each once in topological order
+    for (const auto &nodeId : loaded)
+        if (auto block = delegateModel<FdfBlockModel>(nodeId))
+            block->propagateUpdate();
+    commitUpdate();
+}
+
+void CustomGraph::beginUpdate()
+{
+    ++m_updateDepth;
+}
+
+void CustomGraph::commitUpdate()
+{
+    QTUTILITY_TRACE_SCOPE("commitUpdate");
+    if (m_updateDepth == 0) {
+        qWarning() << "CustomGraph: commitUpdate called without beginUpdate.";
+        return;
+    }
+    if (--m_updateDepth > 0 || m_flushingUpdate)
+        return;
+
+    m_flushingUpdate = true;
+    // blocks made dirty by a propagation are downstream, so they are reached in the same pass
+    while (!m_dirtyNodes.empty()) {
+        for (const auto &nodeId : topologicalOrder()) {
+            if (m_dirtyNodes.erase(nodeId) == 0)
+                continue;
+            if (auto block = delegateModel<FdfBlockModel>(nodeId)) {
+                m_flushingNode = nodeId;
+                block->propagateUpdate();
+            }
+        }
+        // deleted nodes are not in the topological order
+        for (auto it = m_dirtyNodes.begin(); it != m_dirtyNodes.end();)
+            it = nodeExists(*it) ? std::next(it) : m_dirtyNodes.erase(it);
+    }
+    m_flushingNode = QtNodes::InvalidNodeId;
+    m_flushingUpdate = false;
+}
+
+bool CustomGraph::deferPropagation(const QtNodes::NodeId &nodeId)
+{
+    if (m_updateDepth == 0 && !m_flushingUpdate)
+        return false;
+    if (m_flushingUpdate && nodeId == m_flushingNode)
+        return false;
+    m_dirtyNodes.insert(nodeId);
+    return true;
+}
+
+std::shared_ptr<const GraphSnapshot> CustomGraph::snapshot() const
+{
+    if (m_snapshot)
+        return m_snapshot;
+    QTUTILITY_TRACE_SCOPE("snapshot");
+
+    auto nodeIds = allNodeIds();
+    std::vector<QtNodes::ConnectionId> connections;
+    std::unordered_set<QtNodes::NodeId> stale;
+    for (const auto &nodeId : nodeIds)
+        for (const auto &connectionId : allConnectionIds(nodeId)) {
+            if (connectionId.outNodeId != nodeId)
+                continue;
+            connections.push_back(connectionId);
+            // in port names of a block are the out port names of its predecessors
+            if (m_staleSnapshotNodes.count(nodeId) > 0)
+                stale.insert(connectionId.inNodeId);
+        }
+    stale.insert(m_staleSnapshotNodes.begin(), m_staleSnapshotNodes.end());
+    m_staleSnapshotNodes.clear();
+
+    std::vector<std::shared_ptr<const SnapshotNode>> nodes;
+    nodes.reserve(nodeIds.size());
+    for (const auto &nodeId : nodeIds) {
+        auto block = delegateModel<FdfBlockModel>(nodeId);
+        if (!block)
+            continue;
+        auto &record = m_snapshotNodes[nodeId];
+        if (!record || stale.count(nodeId) > 0)
+            record = std::make_shared<const SnapshotNode>(SnapshotNode::fromBlock(nodeId, *block));
+        nodes.push_back(record);
+    }
+    // node ids are not ordered in the graph, keep the snapshot deterministic
+    std::sort(nodes.begin(), nodes.end(), [](const auto &a, const auto &b) { return a->id < b->id; });
+    m_snapshot = std::make_shared<const GraphSnapshot>(std::move(nodes),
+                                                       connections,
+                                                       componentCount() <= 1);
+    return m_snapshot;
+}
+
+size_t CustomGraph::componentCount() const
+{
+    if (m_componentsStale)
+        rebuildComponents();
+    return m_componentCount;
+}
+
+void CustomGraph::revalidate()
+{
+    QTUTILITY_TRACE_SCOPE("revalidate");
+    m_validationTimer.stop();
+    auto stale = std::move(m_staleValidation);
+    m_staleValidation.clear();
+    for (const auto &nodeId : stale) {
+        auto block = delegateModel<FdfBlockModel>(nodeId);
+        if (!block)
+            continue;
+        QStringList problems = block->validityProblems();
+        if (problems == block->shownValidityProblems())
+            continue;
+        block->setValidityProblems(problems);
+        emit nodeUpdated(nodeId);
+    }
+}
+
+void CustomGraph::onBlockChanged(const QtNodes::NodeId &nodeId)
+{
+    m_snapshot.reset();
+    m_staleSnapshotNodes.insert(nodeId);
+    m_staleValidation.insert(nodeId);
+    m_validationTimer.start();
+}
+
+QtNodes::NodeId CustomGraph::findComponent(const QtNodes::NodeId &nodeId) const
+{
+    QtNodes::NodeId root = nodeId;
+    while (m_componentParent.at(root) != root)
+        root = m_componentParent.at(root);
+    // path compression
+    QtNodes::NodeId current = nodeId;
+    while (current != root) {
+        QtNodes::NodeId next = m_componentParent.at(current);
+        m_componentParent[current] = root;
+        current = next;
+    }
+    return root;
+}
+
+void CustomGraph::uniteComponents(const QtNodes::NodeId &a, const QtNodes::NodeId &b) const
+{
+    if (m_componentParent.count(a) == 0 || m_componentParent.count(b) == 0)
+        return;
+    QtNodes::NodeId rootA = findComponent(a);
+    QtNodes::NodeId rootB = findComponent(b);
+    if (rootA == rootB)
+        return;
+    m_componentParent[rootB] = rootA;
+    --m_componentCount;
+}
+
+void CustomGraph::rebuildComponents() const
+{
+    m_componentParent.clear();
+    m_componentCount = 0;
+    auto nodeIds = allNodeIds();
+    for (const auto &nodeId : nodeIds) {
+        m_componentParent[nodeId] = nodeId;
+        ++m_componentCount;
+    }
+    for (const auto &nodeId : nodeIds)
+        for (const auto &connectionId : allConnectionIds(nodeId))
+            if (connectionId.outNodeId == nodeId)
+                uniteComponents(connectionId.outNodeId, connectionId.inNodeId);
+    m_componentsStale = false;
+}
+
 void CustomGraph::stylePorts(const QtNodes::NodeId &nodeId, FdfBlockModel *block)
 {
     if (!block)
@@ -164,28 +416,47 @@ void CustomGraph::onNodeDeleted(const QtNodes::NodeId nodeId)
 {
     // Todo : when datasrc/funcsrc deleted, remove the associated files from m_dataDor
     // so that the dcb created from it is clean
-    removeByValue(m_usedNodeCaptions, nodeId);
-    removeByPairFirst(m_usedOutPortCaptions, nodeId);
-    if (m_dataSourceNodes.find(nodeId) != m_dataSourceNodes.end())
-        m_dataSourceNodes.erase(nodeId);
-    if (m_funcOutNodes.find(nodeId) != m_funcOutNodes.end())
-        m_funcOutNodes.erase(nodeId);
-    if (m_funcSourceNodes.find(nodeId) != m_funcSourceNodes.end())
-        m_funcSourceNodes.erase(nodeId);
-    m_trackedNodes.erase(nodeId);
+    m_snapshot.reset();
+    m_snapshotNodes.erase(nodeId);
+    m_staleSnapshotNodes.erase(nodeId);
+    m_staleValidation.erase(nodeId);
+    m_componentsStale = true;
+    auto captionIt = m_nodeCaptions.find(nodeId);
+    if (captionIt != m_nodeCaptions.end()) {
+        auto usedIt = m_usedNodeCaptions.find(captionIt->second);
+        if (usedIt != m_usedNodeCaptions.end() && usedIt->second == nodeId)
+            m_usedNodeCaptions.erase(usedIt);
+        m_nodeCaptions.erase(captionIt);
+    }
+    auto portsIt = m_outPortNames.find(nodeId);
+    if (portsIt != m_outPortNames.end()) {
+        for (PortIndex i = 0; i < portsIt->second.size(); ++i)
+            releaseOutPortName(nodeId, i);
+        m_outPortNames.erase(portsIt);
+    }
+    unindexNodeTypes(nodeId);
+    m_nodeTypes.erase(nodeId);
+    m_dataSourceNodes.erase(nodeId);
+    m_funcOutNodes.erase(nodeId);
+    m_funcSourceNodes.erase(nodeId);
 }
 
 void CustomGraph::onOutPortInserted(const QtNodes::NodeId nodeId, const QtNodes::PortIndex oldIndex)
 {
+    if (m_bulkLoading)
+        return;
     auto block = delegateModel<FdfBlockModel>(nodeId);
     if (!block)
         return;
     makeOutPortsUnique(nodeId, block, oldIndex);
     stylePorts(nodeId, block);
+    indexNodeTypes(nodeId);
 }
 
 void CustomGraph::onInPortInserted(const QtNodes::NodeId nodeId, const QtNodes::PortIndex oldIndex)
 {
+    if (m_bulkLoading)
+        return;
     auto block = delegateModel<FdfBlockModel>(nodeId);
     if (!block)
         return;
@@ -194,34 +465,48 @@ void CustomGraph::onInPortInserted(const QtNodes::NodeId nodeId, const QtNodes::
 
 void CustomGraph::onOutPortDeleted(const QtNodes::NodeId nodeId, const QtNodes::PortIndex oldIndex)
 {
-    removeByValue(m_usedOutPortCaptions, std::make_pair(nodeId, oldIndex));
-    auto block = delegateModel<FdfBlockModel>(nodeId);
-    if (!block)
+    auto portsIt = m_outPortNames.find(nodeId);
+    if (portsIt == m_outPortNames.end() || oldIndex >= portsIt->second.size())
         return;
-    if (block->nPorts(PortType::Out) > oldIndex)
-        // shift index of ports after the deleted one
-        for (int i = oldIndex; i < block->nPorts(PortType::Out); ++i) {
-            auto caption = block->portCaption(PortType::Out, i);
-            --m_usedOutPortCaptions.at(caption).second;
-        }
+    releaseOutPortName(nodeId, oldIndex);
+    auto &names = portsIt->second;
+    names.erase(names.begin() + oldIndex);
+    // shift index of ports after the deleted one
+    for (PortIndex i = oldIndex; i < names.size(); ++i) {
+        auto usedIt = m_usedOutPortCaptions.find(names[i]);
+        if (usedIt != m_usedOutPortCaptions.end() && usedIt->second.first == nodeId)
+            usedIt->second.second = i;
+    }
+}
+
+void CustomGraph::releaseOutPortName(const QtNodes::NodeId &nodeId, const PortIndex &index)
+{
+    auto portsIt = m_outPortNames.find(nodeId);
+    if (portsIt == m_outPortNames.end() || index >= portsIt->second.size())
+        return;
+    QString &name = portsIt->second[index];
+    auto usedIt = m_usedOutPortCaptions.find(name);
+    if (usedIt != m_usedOutPortCaptions.end() && usedIt->second == std::make_pair(nodeId, index))
+        m_usedOutPortCaptions.erase(usedIt);
+    name.clear();
 }
 
 void CustomGraph::makeCaptionUnique(const QtNodes::NodeId &nodeId, FdfBlockModel *block)
 {
-    QString uniqueCaption = block->caption();
-    uint counter = 1;
-    if (m_trackedNodes.count(nodeId) > 0) { // if node is already tracked
-        if (m_usedNodeCaptions.count(uniqueCaption) > 0
-            && m_usedNodeCaptions.at(uniqueCaption) == nodeId)
+    QString caption = block->caption();
+    auto trackedIt = m_nodeCaptions.find(nodeId);
+    if (trackedIt != m_nodeCaptions.end()) { // if node is already tracked
+        if (trackedIt->second == caption)
             return;
         // if caption is different, remove old caption
-        removeByValue(m_usedNodeCaptions, nodeId);
+        auto usedIt = m_usedNodeCaptions.find(trackedIt->second);
+        if (usedIt != m_usedNodeCaptions.end() && usedIt->second == nodeId)
+            m_usedNodeCaptions.erase(usedIt);
     }
-    while (m_usedNodeCaptions.count(uniqueCaption) > 0)
-        uniqueCaption = QString("%1_%2").arg(block->caption(), QString::number(++counter));
+    QString uniqueCaption = allocateUnique(caption, m_usedNodeCaptions, m_captionSuffixes);
     m_usedNodeCaptions[uniqueCaption] = nodeId;
-    m_trackedNodes.insert(nodeId);
-    if (block->caption() != uniqueCaption)
+    m_nodeCaptions[nodeId] = uniqueCaption;
+    if (caption != uniqueCaption)
         block->setCaption(uniqueCaption);
 }
 
@@ -235,48 +520,89 @@ FdfBlockModel *CustomGraph::getBlockByCaption(const QString &caption) const
     return nullptr;
 }
 
-void CustomGraph::makeOutPortsUnique(const QtNodes::NodeId &nodeId, FdfBlockModel *block)
+void CustomGraph::makeOutPortsUnique(const QtNodes::NodeId &nodeId,
+                                     FdfBlockModel *block,
+                                     bool propagate)
 {
+    QTUTILITY_TRACE_SCOPE("makeOutPortsUnique");
     auto portType = QtNodes::PortType::Out;
     for (uint i = 0; i < block->nPorts(portType); ++i) {
-        makeOutPortsUnique(nodeId, block, i);
+        makeOutPortsUnique(nodeId, block, i, propagate);
     }
 }
 
 void CustomGraph::makeOutPortsUnique(const QtNodes::NodeId &nodeId,
                                      FdfBlockModel *block,
-                                     const PortIndex &index)
+                                     const PortIndex &index,
+                                     bool propagate)
 {
     auto portType = QtNodes::PortType::Out;
     const auto ORIGINAL_NAME = block->portCaption(portType, index);
-    uint counter = 1;
 
-    if (m_trackedNodes.count(nodeId) > 0) {
-        if (m_usedOutPortCaptions.count(ORIGINAL_NAME) > 0
-            && m_usedOutPortCaptions.at(ORIGINAL_NAME) == std::make_pair(nodeId, index))
-            return;
-        // if caption is different, remove old caption
-        removeByValue(m_usedOutPortCaptions, std::make_pair(nodeId, index));
-    }
-    auto uniqueName = ORIGINAL_NAME;
-    while (m_usedOutPortCaptions.count(uniqueName) > 0) {
-        uniqueName = QString("%1_%2").arg(ORIGINAL_NAME, QString::number(++counter));
-    }
+    auto &names = m_outPortNames[nodeId];
+    if (names.size() <= index)
+        names.resize(index + 1);
+    if (!names[index].isEmpty() && names[index] == ORIGINAL_NAME)
+        return;
+    // if caption is different, remove old caption
+    releaseOutPortName(nodeId, index);
+    auto uniqueName = allocateUnique(ORIGINAL_NAME, m_usedOutPortCaptions, m_outPortSuffixes);
     m_usedOutPortCaptions[uniqueName] = std::make_pair(nodeId, index);
-    block->setPortCaption(portType, index, uniqueName);
+    names[index] = uniqueName;
+    if (propagate || uniqueName != ORIGINAL_NAME)
+        block->setPortCaption(portType, index, uniqueName);
 }
 
-bool CustomGraph::verifyBlocksValidity() const
+std::vector<QtNodes::NodeId> CustomGraph::nodesUsingType(const FdfUID &typeId) const
 {
-    for (const auto &nodeId : allNodeIds()) {
-        auto block = delegateModel<FdfBlockModel>(nodeId);
-        if (!block) {
-            qWarning() << "Block with ID" << nodeId << "is not a valid FdfBlockModel.";
-            continue;
-        }
-        if (!block->checkBlockValidity()) {
-            return false;
+    auto it = m_typeUsers.find(typeId);
+    if (it == m_typeUsers.end())
+        return {};
+    return std::vector<QtNodes::NodeId>(it->second.begin(), it->second.end());
+}
+
+void CustomGraph::indexNodeTypes(const QtNodes::NodeId &nodeId)
+{
+    if (m_bulkLoading)
+        return;
+    auto block = delegateModel<FdfBlockModel>(nodeId);
+    if (!block)
+        return;
+    std::vector<FdfUID> types;
+    for (PortIndex i = 0; i < block->nPorts(PortType::Out); ++i) {
+        auto data = block->outData(i);
+        if (auto dataPort = std::dynamic_pointer_cast<DataNode>(data)) {
+            types.push_back(dataPort->typeId());
+        } else if (auto functionPort = std::dynamic_pointer_cast<FunctionNode>(data)) {
+            Signature signature = functionPort->signature();
+            types.insert(types.end(), signature.inputs.begin(), signature.inputs.end());
+            types.insert(types.end(), signature.outputs.begin(), signature.outputs.end());
         }
     }
-    return true;
-}
\ No newline at end of file
+    std::sort(types.begin(), types.end());
+    types.erase(std::unique(types.begin(), types.end()), types.end());
+    types.erase(std::remove(types.begin(), types.end(), UIDManager::NONE_ID), types.end());
+
+    auto &indexed = m_nodeTypes[nodeId];
+    if (indexed == types)
+        return;
+    unindexNodeTypes(nodeId);
+    for (auto &typeId : types)
+        m_typeUsers[typeId].insert(nodeId);
+    indexed = std::move(types);
+}
+
+void CustomGraph::unindexNodeTypes(const QtNodes::NodeId &nodeId)
+{
+    auto typesIt = m_nodeTypes.find(nodeId);
+    if (typesIt == m_nodeTypes.end())
+        return;
+    for (auto &typeId : typesIt->second) {
+        auto usersIt = m_typeUsers.find(typeId);
+        if (usersIt == m_typeUsers.end())
+            continue;
+        usersIt->second.erase(nodeId);
+        if (usersIt->second.empty())
+            m_typeUsers.erase(usersIt);
+    }
+}
@@ -0,0 +1,220 @@
+#include "data/func_archive_index.hpp"
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+
+const QString INDEX_FILE = "index.json";
+constexpr qint64 STREAM_CHUNK_SIZE = 1 << 16;
+
+QJsonArray toJsonArray(const std::vector<int> &ids)
+{
+    QJsonArray array;
+    for (int id : ids)
+        array.append(id);
+    return array;
+}
+
+std::vector<int> fromJsonArray(const QJsonArray &array)
+{
+    std::vector<int> ids;
+    ids.reserve(array.size());
+    for (const QJsonValue &val : array)
+        ids.push_back(val.toInt());
+    return ids;
+}
+
+// fills the entry from the metadata json written by Kedro::postFuncOutModel
+bool parseMetadata(const QByteArray &json, FuncArchiveEntry &entry)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(json);
+    if (!doc.isObject()) {
+        qWarning() << "FuncArchiveIndex: Invalid JSON format.";
+        return false;
+    }
+    QJsonObject meta = doc.object();
+    entry.fileHash = meta["file_hash"].toString().trimmed();
+    if (entry.fileHash.isEmpty()) {
+        qWarning() << "FuncArchiveIndex: file_hash missing in metadata.";
+        return false;
+    }
+    entry.functionName = meta["function_name"].toString();
+    QJsonObject sig = meta["function_signature"].toObject();
+    entry.inputs = fromJsonArray(sig["input"].toArray());
+    entry.outputs = fromJsonArray(sig["output"].toArray());
+    if (entry.inputs.empty() || entry.outputs.empty()) {
+        qWarning() << "FuncArchiveIndex: Invalid or missing function signature in metadata.";
+        return false;
+    }
+    return true;
+}
+
+bool streamToFile(QuaZipFile &source, const QString &destination)
+{
+    QSaveFile out(destination);
+    if (!out.open(QIODevice::WriteOnly)) {
+        qWarning() << "FuncArchiveIndex: Cannot write" << destination;
+        return false;
+    }
+    QByteArray buffer(STREAM_CHUNK_SIZE, Qt::Uninitialized);
+    qint64 read;
+    while ((read = source.read(buffer.data(), buffer.size())) > 0)
+        out.write(buffer.constData(), read);
+    if (read < 0) {
+        out.cancelWriting();
+        return false;
+    }
+    return out.commit();
+}
+
+} // namespace
+
+FuncArchiveIndex &FuncArchiveIndex::instance()
+{
+    static FuncArchiveIndex instance;
+    return instance;
+}
+
+FuncArchiveIndex::FuncArchiveIndex()
+    : m_cacheDir(QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation))
+                     .filePath(QString("DescartesBuilder") + QDir::separator()
+                               + QString("func_archives")))
+{
+    if (!m_cacheDir.exists())
+        m_cacheDir.mkpath(".");
+    readIndex();
+}
+
+std::optional<FuncArchiveEntry> FuncArchiveIndex::load(const QString &zipPath)
+{
+    QString hash = archiveHash(zipPath);
+    if (hash.isEmpty())
+        return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(hash);
+    if (it != m_entries.end() && QFile::exists(it->second.dillPath))
+        return it->second;
+
+    auto entry = extract(zipPath, hash);
+    if (!entry)
+        return std::nullopt;
+    m_entries[hash] = entry.value();
+    writeIndex();
+    return entry;
+}
+
+QString FuncArchiveIndex::archiveHash(const QString &zipPath)
+{
+    QFile file(zipPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "FuncArchiveIndex: Cannot open" << zipPath;
+        return QString();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file))
+        return QString();
+    return QString(hash.result().toHex());
+}
+
+std::optional<FuncArchiveEntry> FuncArchiveIndex::extract(const QString &zipPath,
+                                                          const QString &hash) const
+{
+    QuaZip zip(zipPath);
+    if (!zip.open(QuaZip::mdUnzip)) {
+        qWarning() << "FuncArchiveIndex: Cannot open archive" << zipPath;
+        return std::nullopt;
+    }
+    QDir artifactDir(m_cacheDir.filePath(hash));
+    if (artifactDir.exists())
+        artifactDir.removeRecursively();
+    artifactDir.mkpath(".");
+
+    // single pass over the archive, the metadata stays in memory and the .pkl is streamed
+    QByteArray metadata;
+    FuncArchiveEntry entry;
+    for (bool more = zip.goToFirstFile(); more; more = zip.goToNextFile()) {
+        QString name = zip.getCurrentFileName();
+        bool isJson = name.endsWith(".json");
+        bool isDill = name.endsWith(".pkl");
+        if ((!isJson || !metadata.isEmpty()) && (!isDill || !entry.dillPath.isEmpty()))
+            continue;
+
+        QuaZipFile file(&zip);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "FuncArchiveIndex: Cannot read" << name << "in" << zipPath;
+            continue;
+        }
+        if (isJson) {
+            metadata = file.readAll();
+        } else {
+            QString destination = artifactDir.filePath(QFileInfo(name).fileName());
+            if (streamToFile(file, destination))
+                entry.dillPath = destination;
+        }
+        file.close();
+    }
+    zip.close();
+
+    if (metadata.isEmpty()) {
+        qWarning() << "FuncArchiveIndex: No JSON metadata found in archive.";
+        return std::nullopt;
+    }
+    if (entry.dillPath.isEmpty()) {
+        qWarning() << "FuncArchiveIndex: .pkl missing in archive.";
+        return std::nullopt;
+    }
+    if (!parseMetadata(metadata, entry))
+        return std::nullopt;
+    return entry;
+}
+
+void FuncArchiveIndex::readIndex()
+{
+    QFile file(m_cacheDir.filePath(INDEX_FILE));
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+    QJsonObject index = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = index.begin(); it != index.end(); ++it) {
+        QJsonObject obj = it.value().toObject();
+        FuncArchiveEntry entry;
+        entry.fileHash = obj["file_hash"].toString();
+        entry.functionName = obj["function_name"].toString();
+        entry.inputs = fromJsonArray(obj["input"].toArray());
+        entry.outputs = fromJsonArray(obj["output"].toArray());
+        entry.dillPath = obj["dill_path"].toString();
+        // artifacts can be wiped by the OS as they live in the cache location
+        if (QFile::exists(entry.dillPath))
+            m_entries[it.key()] = entry;
+    }
+}
+
+void FuncArchiveIndex::writeIndex() const
+{
+    QJsonObject index;
+    for (auto &pair : m_entries) {
+        const FuncArchiveEntry &entry = pair.second;
+        index[pair.first] = QJsonObject{{"file_hash", entry.fileHash},
+                                        {"function_name", entry.functionName},
+                                        {"input", toJsonArray(entry.inputs)},
+                                        {"output", toJsonArray(entry.outputs)},
+                                        {"dill_path", entry.dillPath}};
+    }
+    QSaveFile file(m_cacheDir.filePath(INDEX_FILE));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "FuncArchiveIndex: Cannot write the index in" << m_cacheDir.absolutePath();
+        return;
+    }
+    file.write(QJsonDocument(index).toJson(QJsonDocument::Compact));
+    file.commit();
+}
@@ -0,0 +1,199 @@
+#include "data/graph_snapshot.hpp"
+
+#include "ui/models/fdf_block_model.hpp"
+#include "ui/models/io_models.hpp"
+#include <QDebug>
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+using Index = GraphSnapshot::Index;
+using Edge = GraphSnapshot::Edge;
+
+QStringList portNames(const FdfBlockModel &block, const PortType &type)
+{
+    QStringList result;
+    for (PortIndex i = 0; i < block.nPorts(type); ++i)
+        // unconnected in ports have no data
+        if (auto port = block.portData(type, i))
+            result.append(port->type().name);
+    return result;
+}
+
+std::optional<SnapshotNode::CatalogEntry> catalogEntry(const FdfBlockModel &block)
+{
+    if (auto data = dynamic_cast<const DataSourceModel *>(&block)) {
+        QString fileName = data->file().fileName();
+        return SnapshotNode::CatalogEntry{
+            portNames(block, PortType::Out).value(0), data->fileTypeString(), fileName, fileName};
+    }
+    if (auto func = dynamic_cast<const FuncSourceModel *>(&block)) {
+        QString name = func->getFileName();
+        // an empty source is reported when the catalog is written
+        QString source = func->file().fileName().isEmpty() ? QString() : func->dillPath();
+        return SnapshotNode::CatalogEntry{name, func->fileTypeString(), name + ".pkl", source};
+    }
+    if (auto funcOut = dynamic_cast<const FuncOutModel *>(&block)) {
+        QString name = funcOut->getFileName();
+        return SnapshotNode::CatalogEntry{name,
+                                          funcOut->fileTypeString(),
+                                          name + '.' + funcOut->getFileExtenstion(),
+                                          QString()};
+    }
+    return std::nullopt;
+}
+
+// offsets[i]..offsets[i + 1] index the edges of node i
+void buildCsr(size_t nodeCount,
+              std::vector<std::pair<Index, Edge>> &pairs,
+              std::vector<Index> &offsets,
+              std::vector<Edge> &edges)
+{
+    std::sort(pairs.begin(), pairs.end(), [](const auto &a, const auto &b) {
+        return std::tie(a.first, a.second.node, a.second.outPort, a.second.inPort)
+               < std::tie(b.first, b.second.node, b.second.outPort, b.second.inPort);
+    });
+    offsets.assign(nodeCount + 1, 0);
+    edges.clear();
+    edges.reserve(pairs.size());
+    for (auto &pair : pairs) {
+        ++offsets[pair.first + 1];
+        edges.push_back(pair.second);
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+}
+
+} // namespace
+
+SnapshotNode SnapshotNode::fromBlock(const QtNodes::NodeId &id, const FdfBlockModel &block)
+{
+    SnapshotNode node;
+    node.id = id;
+    node.type = block.type();
+    node.name = block.name();
+    node.typeName = block.typeAsString();
+    node.functionName = block.functionName();
+    node.caption = block.caption();
+    node.problems = block.validityProblems();
+    node.hasParameters = block.hasParameters();
+    auto parameters = block.getParameters();
+    node.parameters.assign(parameters.begin(), parameters.end());
+    std::sort(node.parameters.begin(), node.parameters.end());
+    node.inputs = portNames(block, PortType::In);
+    node.outputs = portNames(block, PortType::Out);
+    node.catalog = catalogEntry(block);
+    return node;
+}
+
+GraphSnapshot::GraphSnapshot(std::vector<std::shared_ptr<const SnapshotNode>> nodes,
+                             const std::vector<QtNodes::ConnectionId> &connections,
+                             bool connected)
+    : m_nodes(std::move(nodes))
+    , m_connected(connected)
+{
+    m_indices.reserve(m_nodes.size());
+    for (Index i = 0; i < m_nodes.size(); ++i)
+        m_indices[m_nodes[i]->id] = i;
+
+    std::vector<std::pair<Index, Edge>> outPairs, inPairs;
+    outPairs.reserve(connections.size());
+    inPairs.reserve(connections.size());
+    for (const auto &connection : connections) {
+        auto out = m_indices.find(connection.outNodeId);
+        auto in = m_indices.find(connection.inNodeId);
+        if (out == m_indices.end() || in == m_indices.end())
+            continue;
+        outPairs.push_back(
+            {out->second, {in->second, connection.outPortIndex, connection.inPortIndex}});
+        inPairs.push_back(
+            {in->second, {out->second, connection.outPortIndex, connection.inPortIndex}});
+    }
+    buildCsr(m_nodes.size(), outPairs, m_outOffsets, m_outEdges);
+    buildCsr(m_nodes.size(), inPairs, m_inOffsets, m_inEdges);
+    buildOrder();
+}
+
+std::optional<GraphSnapshot::Index> GraphSnapshot::indexOf(const QtNodes::NodeId &id) const
+{
+    auto it = m_indices.find(id);
+    if (it == m_indices.end())
+        return std::nullopt;
+    return it->second;
+}
+
+GraphSnapshot::EdgeRange GraphSnapshot::successors(Index index) const
+{
+    return {m_outEdges.data() + m_outOffsets[index], m_outEdges.data() + m_outOffsets[index + 1]};
+}
+
+GraphSnapshot::EdgeRange GraphSnapshot::predecessors(Index index) const
+{
+    return {m_inEdges.data() + m_inOffsets[index], m_inEdges.data() + m_inOffsets[index + 1]};
+}
+
+void GraphSnapshot::buildOrder()
+{
+    // multiple connections between the same pair of nodes count once per connection
+    std::vector<Index> inDegree(m_nodes.size());
+    for (Index i = 0; i < m_nodes.size(); ++i)
+        inDegree[i] = m_inOffsets[i + 1] - m_inOffsets[i];
+    m_levels.assign(m_nodes.size(), 0);
+    m_topologicalOrder.clear();
+    m_topologicalOrder.reserve(m_nodes.size());
+    for (Index i = 0; i < m_nodes.size(); ++i)
+        if (inDegree[i] == 0)
+            m_topologicalOrder.push_back(i);
+    for (size_t head = 0; head < m_topologicalOrder.size(); ++head) {
+        Index current = m_topologicalOrder[head];
+        for (const Edge &edge : successors(current)) {
+            m_levels[edge.node] = std::max(m_levels[edge.node], m_levels[current] + 1);
+            if (--inDegree[edge.node] == 0)
+                m_topologicalOrder.push_back(edge.node);
+        }
+    }
+    if (m_topologicalOrder.size() != m_nodes.size())
+        qWarning() << "GraphSnapshot: graph has a cycle, topological order is incomplete.";
+}
+
+bool GraphSnapshot::isConnected(const std::vector<bool> &included) const
+{
+    if (included.empty())
+        return m_connected;
+    // breadth first over the edges in both directions, from the first included block
+    std::vector<bool> reached(m_nodes.size(), false);
+    std::vector<Index> queue;
+    for (Index i = 0; i < m_nodes.size() && queue.empty(); ++i)
+        if (included[i]) {
+            reached[i] = true;
+            queue.push_back(i);
+        }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        for (const auto &range : {successors(queue[head]), predecessors(queue[head])})
+            for (const Edge &edge : range)
+                if (included[edge.node] && !reached[edge.node]) {
+                    reached[edge.node] = true;
+                    queue.push_back(edge.node);
+                }
+    }
+    for (Index i = 0; i < m_nodes.size(); ++i)
+        if (included[i] && !reached[i])
+            return false;
+    return true;
+}
+
+QStringList GraphSnapshot::problems(const std::vector<bool> &included) const
+{
+    QStringList result;
+    if (!isConnected(included))
+        result << "The blocks in the graph are not connected.";
+    for (Index i = 0; i < m_nodes.size(); ++i) {
+        if (!included.empty() && !included[i])
+            continue;
+        for (const auto &problem : m_nodes[i]->problems)
+            result << QString("%1: %2").arg(m_nodes[i]->caption, problem);
+    }
+    return result;
+}
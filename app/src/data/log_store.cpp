@@ -0,0 +1,130 @@
+#include "data/log_store.hpp"
+
+#include <QDebug>
+#include <QDir>
+
+#include <algorithm>
+
+namespace {
+
+// the file grows in steps that double, so the map is replaced a logarithmic number of times
+constexpr qint64 MIN_CAPACITY = 1 << 20; // bytes
+
+char foldAscii(char c)
+{
+    return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+}
+
+} // namespace
+
+LogStore::LogStore()
+    : m_file(QDir::temp().filePath("descartes_log_XXXXXX.txt"))
+    , m_offsets{0}
+{
+    if (!m_file.open())
+        qWarning() << "LogStore: Cannot create" << m_file.fileTemplate()
+                   << ", keeping the log in memory.";
+}
+
+LogStore::~LogStore()
+{
+    if (m_map)
+        m_file.unmap(m_map);
+}
+
+size_t LogStore::append(const QString &text, const QtMsgType &type)
+{
+    QByteArray data = text.toUtf8();
+    if (data.endsWith('\n'))
+        data.chop(1);
+    data.replace('\r', QByteArray());
+    data.append('\n');
+
+    qint64 offset = m_offsets.back();
+    size_t added = 0;
+    for (qsizetype start = 0; start < data.size();) {
+        qsizetype end = data.indexOf('\n', start);
+        offset += end - start + 1;
+        m_offsets.push_back(offset);
+        m_types.push_back(quint8(type));
+        start = end + 1;
+        ++added;
+    }
+    if (m_file.isOpen()) {
+        // the unused end of the file is zeros, reads stop at the last offset
+        if (offset > m_capacity) {
+            m_capacity = std::max({m_capacity * 2, offset, MIN_CAPACITY});
+            if (!m_file.resize(m_capacity))
+                qWarning() << "LogStore: Cannot grow" << m_file.fileName() << m_file.errorString();
+        }
+        if (m_file.write(data) != data.size())
+            qWarning() << "LogStore: Cannot write" << m_file.fileName() << m_file.errorString();
+    } else
+        m_memory.append(data);
+    return added;
+}
+
+QString LogStore::line(size_t index) const
+{
+    auto text = bytes(index);
+    return QString::fromUtf8(text.data(), text.size());
+}
+
+bool LogStore::contains(size_t index, const QByteArray &needle) const
+{
+    // only [A-Z] is folded, latin-1 folding would change the bytes of utf-8 sequences
+    auto text = bytes(index);
+    auto equal = [](char a, char b) { return foldAscii(a) == foldAscii(b); };
+    return std::search(text.begin(), text.end(), needle.begin(), needle.end(), equal)
+           != text.end();
+}
+
+void LogStore::clear()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+        m_mappedSize = 0;
+    }
+    if (m_file.isOpen())
+        m_file.resize(0);
+    m_capacity = 0;
+    m_flushedSize = 0;
+    m_memory.clear();
+    m_offsets.assign(1, 0);
+    m_types.clear();
+}
+
+QLatin1String LogStore::bytes(size_t index) const
+{
+    qint64 start = m_offsets[index];
+    qint64 length = m_offsets[index + 1] - start - 1; // without the '\n'
+    if (!m_file.isOpen())
+        return QLatin1String(m_memory.constData() + start, length);
+    // the map sees what is written to the file, once it leaves the buffer of QFile
+    if (m_offsets[index + 1] > m_flushedSize) {
+        m_file.flush();
+        m_flushedSize = m_offsets.back();
+    }
+    if (m_offsets[index + 1] > m_mappedSize)
+        remap();
+    if (!m_map || m_offsets[index + 1] > m_mappedSize)
+        return QLatin1String();
+    return QLatin1String(reinterpret_cast<const char *>(m_map) + start, length);
+}
+
+void LogStore::remap() const
+{
+    // the whole capacity is mapped, only growing the file needs a new map
+    if (m_map)
+        m_file.unmap(m_map);
+    m_mappedSize = m_file.size();
+    m_map = m_mappedSize > 0 ? m_file.map(0, m_mappedSize) : nullptr;
+    if (!m_map) {
+        m_mappedSize = 0;
+        // the warning is shown by a log view, repeating it would feed itself
+        if (!m_mapFailed)
+            qWarning() << "LogStore: Cannot map" << m_file.fileName() << m_file.errorString();
+        m_mapFailed = true;
+    }
+}
@@ -1,13 +1,30 @@
 #include "data/settings.hpp"
 
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSettings>
+
 namespace {
 
 const std::map<QString, QVariant> DEFAULT_VALUES = {
     {"engine", "kedro"},
     {"engine timeout (minutes)", 5},
     {"default export format", ".dcb (Graph + data)"},
+    {"reuse cached runs", true},
+    {"fuse block chains", true},
+    {"preview rows", 1000},
+    {"preview max iterations", 20},
 };
 
+// the names of the application when it sets them, the tests do to keep out of the builder settings
+std::unique_ptr<QSettings> openStore()
+{
+    if (!QCoreApplication::organizationName().isEmpty())
+        return std::make_unique<QSettings>(QCoreApplication::organizationName(),
+                                           QCoreApplication::applicationName());
+    return std::make_unique<QSettings>("CNRS@CREATE", "DesCartes Builder");
+}
+
 }
 
 namespace data {
@@ -18,35 +35,98 @@ Settings &Settings::instance()
 }
 
 Settings::Settings()
-    : m_settings("CNRS@CREATE", "DesCartes Builder")
 {
+    // one thread so writes stay in order
+    m_persistPool.setMaxThreadCount(1);
+    auto snapshot = std::make_shared<Snapshot>(DEFAULT_VALUES);
     // init the default values if they don't exist
+    auto store = openStore();
     for (auto pair : DEFAULT_VALUES)
-        if (!m_settings.contains(pair.first))
-            m_settings.setValue(pair.first, pair.second);
+        if (!store->contains(pair.first))
+            store->setValue(pair.first, pair.second);
+    for (const auto &key : store->allKeys())
+        (*snapshot)[key] = store->value(key);
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
 }
 
-Settings::~Settings() {}
+Settings::~Settings()
+{
+    flush();
+}
 
 void Settings::setValue(const QString &key, const QVariant &value)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_settings.setValue(key, value);
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        auto current = std::atomic_load(&m_snapshot);
+        auto it = current->find(key);
+        if (it != current->end() && it->second == value)
+            return;
+        // settings are few, copying them all keeps every snapshot immutable
+        auto next = std::make_shared<Snapshot>(*current);
+        (*next)[key] = value;
+        std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(next)));
+        // a persist already queued picks this value up too
+        bool queued = !m_unpersisted.empty();
+        m_unpersisted[key] = value;
+        if (!queued)
+            m_persistPool.start([this]() { persist(); });
+    }
     emit settingUpdated(key, value);
 }
 
 QVariant Settings::value(const QString &key) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (DEFAULT_VALUES.count(key) > 0)
-        return m_settings.value(key, DEFAULT_VALUES.at(key));
-    return m_settings.value(key);
+    auto current = std::atomic_load(&m_snapshot);
+    auto it = current->find(key);
+    if (it != current->end())
+        return it->second;
+    return QVariant();
+}
+
+std::shared_ptr<const Settings::Snapshot> Settings::snapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
+QMetaObject::Connection Settings::subscribe(const QString &key,
+                                            const QObject *context,
+                                            std::function<void(const QVariant &)> callback)
+{
+    return connect(this,
+                   &Settings::settingUpdated,
+                   context,
+                   [key, callback](const QString &updatedKey, const QVariant &value) {
+                       if (updatedKey == key)
+                           callback(value);
+                   });
+}
+
+void Settings::flush()
+{
+    m_persistPool.waitForDone();
+}
+
+void Settings::persist()
+{
+    Snapshot values;
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        values.swap(m_unpersisted);
+    }
+    // QSettings posts its updates to the thread that created it, so each persist has its own
+    auto store = openStore();
+    for (const auto &[key, value] : values)
+        store->setValue(key, value);
+    store->sync();
+    if (store->status() != QSettings::NoError)
+        qWarning() << "Settings: Cannot write" << store->fileName();
 }
 
 void Settings::printAll() const
 {
-    for (auto &pair : DEFAULT_VALUES)
-        qDebug() << pair.first << ": " << value(pair.first);
+    for (auto &pair : *snapshot())
+        qDebug() << pair.first << ": " << pair.second;
 }
 
-} // namespace data
\ No newline at end of file
+} // namespace data
@@ -3,6 +3,7 @@
 #include "ui/models/function_names.hpp"
 #include <QDebug>
 #include <QFileDialog>
+#include <QHash>
 #include <QJsonArray>
 #include <QMessageBox>
 #include <QStandardPaths>
@@ -10,11 +11,13 @@
 #include <QtNodes/DagGraphicsScene>
 #include <QtNodes/DirectedAcyclicGraphModel>
 #include <QtNodes/GraphicsView>
+#include <QtUtility/trace/trace.hpp>
 
 #include <quazip/JlCompress.h>
 
 #include "data/block_manager.hpp"
 #include "data/custom_graph.hpp"
+#include "ui/level_of_detail.hpp"
 #include "ui/models/io_models.hpp"
 
 using QtNodes::DagGraphicsScene;
@@ -44,6 +47,7 @@ TabComponents::TabComponents(QWidget *parent, std::optional<QFileInfo> fileInfo)
     // touch pad seems to trigger touch events, so touch events are disabled to supress the bug
     m_view->viewport()->setAttribute(Qt::WA_AcceptTouchEvents, false);
     m_uidManager->setGraph(m_graph);
+    new LevelOfDetail(m_graph, m_view); // owned by the view
     connect(m_graph,
             &DirectedAcyclicGraphModel::graphLoadedFromFile,
             this,
@@ -104,15 +108,22 @@ bool TabComponents::save()
             return false;
     }
 
+    QTUTILITY_TRACE_SCOPE("save");
     QString sceneFilename = "scene" + SCENE_EXTENSION; // maintain 1 dag file per dcb
     QJsonObject metadata;                              // save metadata
     if (m_globals.m_randomState.has_value()) {
         metadata["random_state"] = *m_globals.m_randomState;
     }
-    if (!m_scene->save(m_dataDir.absoluteFilePath(sceneFilename), metadata))
-        return false;
-    if (!JlCompress::compressDir(m_localFile.absoluteFilePath(), m_dataDir.absolutePath()))
-        return false;
+    {
+        QTUTILITY_TRACE_SCOPE("save scene");
+        if (!m_scene->save(m_dataDir.absoluteFilePath(sceneFilename), metadata))
+            return false;
+    }
+    {
+        QTUTILITY_TRACE_SCOPE("compress dcb");
+        if (!JlCompress::compressDir(m_localFile.absoluteFilePath(), m_dataDir.absolutePath()))
+            return false;
+    }
     qInfo() << "File saved to: " << m_localFile.absoluteFilePath();
     return true;
 }
@@ -167,13 +178,24 @@ bool TabComponents::openExisting()
         return false;
     }
 
-    JlCompress::extractDir(m_localFile.absoluteFilePath(), m_dataDir.absolutePath());
+    QTUTILITY_TRACE_SCOPE("open");
+    {
+        QTUTILITY_TRACE_SCOPE("extract dcb");
+        JlCompress::extractDir(m_localFile.absoluteFilePath(), m_dataDir.absolutePath());
+    }
     QString sceneFilename = "scene" + SCENE_EXTENSION;
     if (!m_dataDir.exists(sceneFilename)) {
         qWarning() << "Scene file does not exist:" << sceneFilename;
         return false;
     }
-    if (!m_scene->load(m_dataDir.absoluteFilePath(sceneFilename)))
+    m_graph->beginBulkLoad();
+    bool loaded = false;
+    {
+        QTUTILITY_TRACE_SCOPE("load scene");
+        loaded = m_scene->load(m_dataDir.absoluteFilePath(sceneFilename));
+    }
+    m_graph->endBulkLoad();
+    if (!loaded)
         return false;
     loadMetadataFromExisting(sceneFilename); // Load additional metadata such as global variables
     return true;
@@ -282,6 +304,7 @@ void TabComponents::onFuncSourceImportClicked(const QtNodes::NodeId nodeId)
 
 void TabComponents::postLoadProcess(const QJsonArray &nodesJsonArray)
 {
+    QTUTILITY_TRACE_SCOPE("postLoadProcess");
     // This function is called after the graph is loaded from a file. It reloads the type tags
     // and annotations for the output ports of the nodes based on the saved JSON data.
     if (nodesJsonArray.isEmpty()) {
@@ -289,21 +312,19 @@ void TabComponents::postLoadProcess(const QJsonArray &nodesJsonArray)
         return;
     }
 
-    auto findById = [](const QJsonArray &array, int idToFind) -> QJsonObject {
-        for (const QJsonValue &value : array) {
-            if (value.isObject()) {
-                QJsonObject obj = value.toObject();
-                if (obj.contains("id") && obj["id"].toInt() == idToFind) {
-                    return obj;
-                }
-            }
-        }
-        return QJsonObject();
-    };
+    // index the saved nodes once, instead of searching the array for every node
+    QHash<int, QJsonObject> nodesById;
+    nodesById.reserve(nodesJsonArray.size());
+    for (const QJsonValue &value : nodesJsonArray) {
+        QJsonObject obj = value.toObject();
+        if (obj.contains("id"))
+            nodesById.insert(obj["id"].toInt(), obj);
+    }
 
+    // captions and port uniqueness are applied once when the bulk load ends
     for (const auto &id : m_graph->allNodeIds()) {
-        QJsonObject nodeJson = findById(nodesJsonArray, id);
-        if (nodeJson.isEmpty()) {
+        auto nodeIt = nodesById.constFind(id);
+        if (nodeIt == nodesById.constEnd()) {
             qWarning() << "Node with ID" << id << "not found in the loaded graph.";
             continue;
         }
@@ -312,7 +333,7 @@ void TabComponents::postLoadProcess(const QJsonArray &nodesJsonArray)
             continue;
         }
 
-        QJsonArray outputPorts = nodeJson["internal-data"].toObject()["output_ports"].toArray();
+        QJsonArray outputPorts = nodeIt->value("internal-data").toObject()["output_ports"].toArray();
         for (const auto &outputPort : outputPorts) {
             QJsonObject portJson = outputPort.toObject();
             int index = portJson["index"].toInt();
@@ -321,13 +342,9 @@ void TabComponents::postLoadProcess(const QJsonArray &nodesJsonArray)
                 if (auto port = std::dynamic_pointer_cast<DataNode>(block->outData(index))) {
                     port->setAnnotation(portJson["annotation"].toString());
                     port->setTypeTagName(portJson["type_tag"].toString());
-                    // Ensure output ports have unique captions after loading
-                    Q_EMIT block->outPortCaptionUpdated(index, port->name());
                 } else if (auto port = std::dynamic_pointer_cast<FunctionNode>(
                                block->outData(index))) {
                     port->setName(portJson["caption"].toString());
-                    // Ensure output ports have unique captions after loading
-                    Q_EMIT block->outPortCaptionUpdated(index, port->name());
                 }
             }
         }
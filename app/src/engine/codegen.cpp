@@ -0,0 +1,181 @@
+#include "engine/codegen.hpp"
+
+#include "ui/models/fdf_block_model.hpp"
+#include "ui/models/function_names.hpp"
+
+#include <limits>
+#include <numeric>
+
+namespace codegen {
+
+namespace {
+
+using Index = GraphSnapshot::Index;
+constexpr Index NONE = std::numeric_limits<Index>::max();
+
+// the only included block reading the results of sources, NONE when there are several or none
+Index soleConsumer(const GraphSnapshot &snapshot,
+                   const std::vector<Index> &sources,
+                   const Plan &plan)
+{
+    Index consumer = NONE;
+    for (auto source : sources)
+        for (const auto &edge : snapshot.successors(source)) {
+            if (!plan.includes(edge.node))
+                continue;
+            if (consumer != NONE && edge.node != consumer)
+                return NONE;
+            consumer = edge.node;
+        }
+    return consumer;
+}
+
+// equal for blocks that compute the same, inputs are compared after the merges so far
+QString signature(const SnapshotNode &node, const Plan &plan)
+{
+    QStringList parts = {node.typeName,
+                         node.name,
+                         node.functionName,
+                         QString::number(node.outputs.size()),
+                         node.hasParameters ? "params" : ""};
+    for (const auto &[key, value] : node.parameters)
+        parts << key + '=' + value;
+    for (const auto &input : node.inputs) {
+        auto alias = plan.aliases.find(input);
+        parts << (alias == plan.aliases.end() ? input : alias->second);
+    }
+    return parts.join('\n');
+}
+
+bool feedsOutputBlock(const GraphSnapshot &snapshot, Index index)
+{
+    for (const auto &edge : snapshot.successors(index))
+        if (!isPipelineNode(snapshot.node(edge.node)))
+            return true;
+    return false;
+}
+
+} // namespace
+
+bool isPipelineNode(const SnapshotNode &node)
+{
+    auto type = static_cast<FdfBlockModel::FdfType>(node.type);
+    return type != FdfBlockModel::Data && type != FdfBlockModel::Output;
+}
+
+bool isSink(const SnapshotNode &node)
+{
+    return node.name == processor_function::SCORE
+           || node.name == processor_function::SENSITIVITY_ANALYSIS
+           || node.name == io_names::FUNC_OUT || node.name == io_names::DATA_OUT
+           || node.name == io_names::GRAPH_FUNCTION;
+}
+
+std::vector<Index> sinks(const GraphSnapshot &snapshot)
+{
+    std::vector<Index> result;
+    for (Index i = 0; i < snapshot.size(); ++i)
+        if (isSink(snapshot.node(i)))
+            result.push_back(i);
+    return result;
+}
+
+std::vector<bool> upstreamClosure(const GraphSnapshot &snapshot, const std::vector<Index> &targets)
+{
+    std::vector<bool> reached(snapshot.size(), false);
+    std::vector<Index> stack;
+    for (auto target : targets)
+        if (!reached[target]) {
+            reached[target] = true;
+            stack.push_back(target);
+        }
+    while (!stack.empty()) {
+        Index index = stack.back();
+        stack.pop_back();
+        for (const auto &edge : snapshot.predecessors(index))
+            if (!reached[edge.node]) {
+                reached[edge.node] = true;
+                stack.push_back(edge.node);
+            }
+    }
+    return reached;
+}
+
+std::vector<std::pair<Index, Index>> mergeDuplicates(const GraphSnapshot &snapshot, Plan &plan)
+{
+    std::vector<std::pair<Index, Index>> merged;
+    std::unordered_map<QString, Index> kept;
+    for (auto index : snapshot.topologicalOrder()) {
+        const SnapshotNode &node = snapshot.node(index);
+        if (!plan.includes(index) || !isPipelineNode(node) || isSink(node))
+            continue;
+        auto [first, inserted] = kept.emplace(signature(node, plan), index);
+        // the datasets of output blocks are named after the block that writes them
+        if (inserted || feedsOutputBlock(snapshot, index))
+            continue;
+        if (plan.included.empty())
+            plan.included.assign(snapshot.size(), true);
+        if (plan.sameAs.empty()) {
+            plan.sameAs.resize(snapshot.size());
+            std::iota(plan.sameAs.begin(), plan.sameAs.end(), Index(0));
+        }
+        plan.included[index] = false;
+        plan.sameAs[index] = first->second;
+        const SnapshotNode &keptNode = snapshot.node(first->second);
+        for (int i = 0; i < node.outputs.size(); ++i)
+            plan.aliases[node.outputs[i]] = keptNode.outputs[i];
+        merged.emplace_back(index, first->second);
+    }
+    return merged;
+}
+
+std::vector<Chain> fusableChains(const GraphSnapshot &snapshot, const Plan &plan)
+{
+    const size_t size = snapshot.size();
+    // the readers of a merged block read the block kept in its place
+    std::vector<std::vector<Index>> sources(size);
+    for (Index i = 0; i < size; ++i)
+        sources[plan.resultOf(i)].push_back(i);
+    std::vector<Index> next(size, NONE);
+    std::vector<int> feeders(size, 0); // blocks that would link into each block
+    for (Index i = 0; i < size; ++i) {
+        if (!isPipelineNode(snapshot.node(i)) || !plan.includes(i))
+            continue;
+        Index consumer = soleConsumer(snapshot, sources[i], plan);
+        if (consumer != NONE && isPipelineNode(snapshot.node(consumer))) {
+            next[i] = consumer;
+            ++feeders[consumer];
+        }
+    }
+    // a block fed by several such blocks would make a tree, it starts a new run instead
+    std::vector<bool> linked(size, false);
+    for (Index i = 0; i < size; ++i) {
+        if (next[i] == NONE)
+            continue;
+        if (feeders[next[i]] == 1)
+            linked[next[i]] = true;
+        else
+            next[i] = NONE;
+    }
+
+    std::vector<Chain> chains;
+    for (auto index : snapshot.topologicalOrder()) {
+        if (linked[index] || next[index] == NONE)
+            continue;
+        Chain chain{index};
+        while (next[chain.back()] != NONE)
+            chain.push_back(next[chain.back()]);
+        chains.push_back(std::move(chain));
+    }
+    return chains;
+}
+
+QString describe(const GraphSnapshot &snapshot, const Chain &chain)
+{
+    QStringList captions;
+    for (auto index : chain)
+        captions << snapshot.node(index).caption;
+    return captions.join(" -> ");
+}
+
+} // namespace codegen
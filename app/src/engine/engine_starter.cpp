@@ -7,7 +7,7 @@
 
 std::unique_ptr<AbstractEngine> EngineStarter::init()
 {
-    auto engine = data::Settings::instance().value("engine").toString().toLower();
+    auto engine = data::Settings::instance().get<QString>("engine").toLower();
     if (engine == "kedro")
         return std::make_unique<Kedro>();
     qWarning() << "Engine can't be found, defaulting to Kedro";
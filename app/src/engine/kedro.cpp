@@ -2,26 +2,37 @@
 
 #include <QApplication>
 #include <QCryptographicHash>
+#include <QDateTime>
+#include <QDirIterator>
 #include <QJsonArray>
 #include <QProcess>
+#include <QSet>
 #include <QStandardPaths>
 
 #include <QtNodes/DirectedAcyclicGraphModel>
 
 #include <QtUtility/file/file.hpp>
+#include <QtUtility/trace/trace.hpp>
 
 #include "data/yml_parser.hpp"
 #include <quazip/JlCompress.h>
 
 #include "data/constants.hpp"
 #include "data/custom_graph.hpp"
+#include "data/graph_snapshot.hpp"
 #include "data/settings.hpp"
 #include "data/tab_components.hpp"
+#include "engine/codegen.hpp"
+#include "engine/preview.hpp"
 #include "ui/models/fdf_block_model.hpp"
+#include "ui/models/function_names.hpp"
 #include "ui/models/io_models.hpp"
 #include "ui/models/processor_models.hpp"
+#include "ui/models/trainer_models.hpp"
 
 #include "engine/kedro.hpp"
+#include <algorithm>
+#include <functional>
 #include <iostream>
 
 #ifdef Q_OS_WIN
@@ -32,10 +43,9 @@
 
 using Settings = data::Settings;
 
-namespace {
+namespace trace = QtUtility::trace;
 
-using FdfType = FdfBlockModel::FdfType;
-const std::unordered_set<FdfType> EXCLUDED_TYPES = {FdfType::Data, FdfType::Output};
+namespace {
 
 QString singleQuote(const QString &string)
 {
@@ -47,14 +57,11 @@ QString quote(const QString &string)
     return '\"' + string + '\"';
 }
 
-QStringList getPortList(const FdfBlockModel &block, const PortType &type)
+QStringList quoteAll(const QStringList &strings)
 {
     QStringList result;
-    for (PortIndex i = 0; i < block.nPorts(type); ++i) {
-        // if an in port is not connected it is null, the 'if' can be removed after the validity check handles it
-        if (auto port = block.portData(type, i))
-            result.append(quote(port->type().name));
-    }
+    for (const auto &string : strings)
+        result.append(quote(string));
     return result;
 }
 
@@ -106,20 +113,47 @@ QDir getKedroUmbrellaDir(QString const &pythonExecutable)
     return QDir(kedroUmbrellaPath);
 }
 
-QString toString(const FdfBlockModel &block)
+// changes whenever the python or the installed kedro-umbrella package changes
+QString engineVersion(const QString &pythonExecutable, const QDir &kedroUmbrellaDir)
 {
-    QString result = block.typeAsString() + '(';
-    if (!block.functionName().isEmpty())
-        result += QString("func=%1,").arg(block.functionName());
-    result += QString("name=%1").arg(quote(block.caption()));
-    QStringList inputs = getPortList(block, PortType::In);
-    if (block.hasParameters())
-        inputs << quote(QString("params:%1").arg(block.caption()));
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(pythonExecutable.toUtf8());
+    QStringList files;
+    QDirIterator it(kedroUmbrellaDir.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString file = it.next();
+        if (!file.contains("__pycache__"))
+            files << file;
+    }
+    files.sort();
+    for (const auto &file : files) {
+        QFileInfo info(file);
+        hash.addData(kedroUmbrellaDir.relativeFilePath(file).toUtf8() + '\0'
+                     + QByteArray::number(info.size()) + '\0'
+                     + QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + '\0');
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString toString(const SnapshotNode &node, const std::unordered_map<QString, QString> &aliases)
+{
+    QString result = node.typeName + '(';
+    if (!node.functionName.isEmpty())
+        result += QString("func=%1,").arg(node.functionName);
+    result += QString("name=%1").arg(quote(node.caption));
+    // if an in port is not connected it has no dataset, the validity check reports it
+    QStringList inputs;
+    for (const auto &input : node.inputs) {
+        auto alias = aliases.find(input);
+        inputs << quote(alias == aliases.end() ? input : alias->second);
+    }
+    if (node.hasParameters)
+        inputs << quote(QString("params:%1").arg(node.caption));
     if (inputs.size() == 1)
         result += QString(",inputs=%1").arg(inputs.at(0));
     else if (inputs.size() > 1)
         result += QString(",inputs=[%1]").arg(inputs.join(','));
-    QStringList outputs = getPortList(block, PortType::Out);
+    QStringList outputs = quoteAll(node.outputs);
     if (outputs.size() == 1)
         result += QString(",outputs=%1").arg(outputs.at(0));
     else if (outputs.size() > 1)
@@ -128,9 +162,104 @@ QString toString(const FdfBlockModel &block)
     return result;
 }
 
+// the functions kedro_umbrella.library provides, other function names come from the nodes.py
+// of the workspace
+const QSet<QString> LIBRARY_FUNCTIONS = {processor_function::SPLIT_DATA,
+                                         processor_function::DIFFERENCE,
+                                         processor_function::SCORE,
+                                         processor_function::LOAD_MAT,
+                                         processor_function::SENSITIVITY_ANALYSIS,
+                                         coder_function::TRANSFORM_DATA,
+                                         coder_function::REDUCE_DATA,
+                                         trainer_function::BASIC_TRAINER,
+                                         trainer_function::PYTORCH_TRAINER};
+
+// imports the block types and functions of the included nodes only, the star imports of the
+// library and nodes.py are what makes a small pipeline slow to start
+QString imports(const GraphSnapshot &snapshot, const codegen::Plan &plan)
+{
+    QStringList types;
+    QStringList functions;
+    bool workspaceFunctions = false;
+    for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i) {
+        const SnapshotNode &node = snapshot.node(i);
+        if (!codegen::isPipelineNode(node) || !plan.includes(i))
+            continue;
+        types << node.typeName;
+        if (LIBRARY_FUNCTIONS.contains(node.functionName))
+            functions << node.functionName;
+        else if (!node.functionName.isEmpty())
+            workspaceFunctions = true;
+    }
+    types.sort();
+    types.removeDuplicates();
+    functions.sort();
+    functions.removeDuplicates();
+    QStringList lines;
+    if (!types.isEmpty())
+        lines << QString("from kedro_umbrella import %1").arg(types.join(", "));
+    if (!functions.isEmpty())
+        lines << QString("from kedro_umbrella.library import %1").arg(functions.join(", "));
+    if (workspaceFunctions)
+        lines << "from .nodes import *";
+    return lines.join('\n');
+}
+
+// Takes the lines python writes with -X importtime out of the error output. Returns the modules
+// imported at the top level that took the longest, with the time of all imports.
+QString importTimeReport(QByteArray &errorOutput)
+{
+    static const QByteArray PREFIX = "import time:";
+    QByteArrayList kept;
+    std::vector<std::pair<qint64, QString>> modules; // cumulative microseconds, module
+    qint64 total = 0;
+    for (const auto &line : errorOutput.split('\n')) {
+        if (!line.startsWith(PREFIX)) {
+            kept << line;
+            continue;
+        }
+        // "import time: self [us] | cumulative | imported package"
+        auto fields = line.mid(PREFIX.size()).split('|');
+        bool ok = false;
+        qint64 cumulative = fields.value(1).trimmed().toLongLong(&ok);
+        QByteArray module = fields.value(2);
+        // nested imports are indented further, their time is part of the top level import
+        if (!ok || fields.size() != 3 || module.startsWith("  "))
+            continue;
+        total += cumulative;
+        modules.emplace_back(cumulative, QString::fromUtf8(module.trimmed()));
+    }
+    errorOutput = kept.join('\n').trimmed();
+    if (modules.empty())
+        return QString();
+    std::sort(modules.begin(), modules.end(), std::greater<>());
+    QString report = QString("\nIMPORT TIME: %1 s\n").arg(total / 1e6, 0, 'f', 3);
+    const size_t size = std::min(modules.size(), size_t(constants::kedro::IMPORT_REPORT_SIZE));
+    for (size_t i = 0; i < size; ++i)
+        report += QString("%1 s  %2\n")
+                      .arg(modules[i].first / 1e6, 0, 'f', 3)
+                      .arg(modules[i].second);
+    return report;
+}
+
+// cached results stand in for a run only when running again gives the same results
+bool cachesRuns(const TabComponents &tab)
+{
+    if (!Settings::instance().get<bool>("reuse cached runs"))
+        return false;
+    // the tests are there to exercise kedro
+    if (!qEnvironmentVariableIsEmpty("TEST_MODE"))
+        return false;
+    if (!tab.getRandomState()) {
+        qInfo() << "Runs without a random state vary, set one in Globals to reuse identical runs";
+        return false;
+    }
+    return true;
+}
+
 int timeoutMinutes()
 {
-    return Settings::instance().value("engine timeout (minutes)").toInt();
+    return Settings::instance().get<int>("engine timeout (minutes)");
 }
 
 } // namespace
@@ -140,6 +269,7 @@ Kedro::Kedro()
     , m_setup(false)
     , m_PYTHON_EXECUTABLE(getPythonExecutable())
     , m_KEDRO_UMBRELLA_DIR(getKedroUmbrellaDir(m_PYTHON_EXECUTABLE))
+    , m_ENGINE_VERSION(engineVersion(m_PYTHON_EXECUTABLE, m_KEDRO_UMBRELLA_DIR))
     , m_execution(std::make_unique<ExecutionBundle>())
     , m_DEFAULT_TEMPLATE(m_KEDRO_UMBRELLA_DIR.absoluteFilePath("template/builder-spring/"))
 {
@@ -149,6 +279,8 @@ Kedro::Kedro()
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     env.insert("COLUMNS", "200");
     env.insert("LINES", "25");
+    // python keeps the bytecode of the library and nodes.py in __pycache__ between runs
+    env.remove("PYTHONDONTWRITEBYTECODE");
     m_execution->process.setProcessEnvironment(env); // this is for kedro logger to print better
     m_execution->process.setProgram(m_PYTHON_EXECUTABLE);
     m_execution->process.setArguments({"-m", "kedro", "run"});
@@ -165,7 +297,7 @@ Kedro::~Kedro()
     disconnect(&m_execution->process, &QProcess::finished, this, &Kedro::onExecutionFinished);
 }
 
-bool Kedro::execute(std::shared_ptr<TabComponents> tab)
+bool Kedro::execute(std::shared_ptr<TabComponents> tab, const RunOptions &options)
 {
     if (m_execution->inProgress) {
         qInfo() << "There is already an execution in progress, please wait.";
@@ -183,48 +315,211 @@ bool Kedro::execute(std::shared_ptr<TabComponents> tab)
     };
 
     qDebug() << "Kedro is executing...";
-    if (!validityCheck(tab))
+    auto snapshot = tab->getGraph()->snapshot();
+    auto plan = makePlan(*snapshot, options);
+    if (!plan || !validityCheck(*snapshot, *plan))
         return falseAndRelease();
+    if (options.preview) {
+        auto &settings = Settings::instance();
+        plan->preview = codegen::Preview{settings.get<int>("preview rows"),
+                                         settings.get<int>("preview max iterations"),
+                                         quint32(tab->getRandomState().value_or(0))};
+        qInfo() << "Preview run on" << plan->preview->rows << "rows of each csv data source";
+    }
     if (!m_setup) {
         qCritical() << "Kedro is not setup yet, please setup kedro before executing";
         return falseAndRelease();
     }
-    m_execution->tab = tab;
-    m_execution->project = initWorkspace(tab);
-    if (!generateParametersYml(m_execution->project, tab->getGraph()))
-        return falseAndRelease();
-    if (!generateCatalogYml(m_execution->project, tab))
-        return falseAndRelease();
-    if (!generatePipelinePy(m_execution->project, tab->getGraph()))
-        return falseAndRelease();
+    {
+        QTUTILITY_TRACE_SCOPE("codegen");
+        m_execution->tab = tab;
+        m_execution->snapshot = snapshot;
+        m_execution->plan = std::move(*plan);
+        m_execution->project = initWorkspace(tab);
+        const auto &project = m_execution->project;
+        if (!generateParametersYml(project, *snapshot, m_execution->plan))
+            return falseAndRelease();
+        if (!generateCatalogYml(project, tab, *snapshot, m_execution->plan))
+            return falseAndRelease();
+        if (!generatePipelinePy(project, *snapshot, m_execution->plan))
+            return falseAndRelease();
+    }
+
+    m_execution->runKey = cachesRuns(*tab) ? runFingerprint(tab, *snapshot, m_execution->plan)
+                                           : QString();
+    m_execution->outputs = runOutputs(*snapshot, m_execution->plan);
+    if (!m_execution->runKey.isEmpty() && m_runCache.contains(m_execution->runKey)) {
+        // finish from the event loop, like a kedro run
+        QTimer::singleShot(0, this, &Kedro::onCachedRun);
+        return true;
+    }
+    startRun();
+    return true;
+}
+
+void Kedro::startRun()
+{
+    // the python side adds its node timings to the trace when this is set, and its module load
+    // times to the error output which the run output summarises
+    auto env = m_execution->process.processEnvironment();
+    if (trace::isEnabled()) {
+        env.insert(constants::kedro::TRACE_FILE_ENV, traceEventFiles().value(0));
+        env.insert(constants::kedro::IMPORT_TIME_ENV, "1");
+    } else {
+        env.remove(constants::kedro::TRACE_FILE_ENV);
+        env.remove(constants::kedro::IMPORT_TIME_ENV);
+    }
+    m_execution->process.setProcessEnvironment(env);
+    m_execution->traceStart = trace::isEnabled() ? trace::now() : -1;
 
     // call kedro run
     m_execution->process.setWorkingDirectory(m_execution->project.absolutePath());
     m_execution->process.start();
-    return true;
+}
+
+QStringList Kedro::traceEventFiles() const
+{
+    return {m_runtimeCache.filePath("python_trace.jsonl")};
 }
 
 bool Kedro::validityCheck(std::shared_ptr<TabComponents> tab)
 {
-    auto graph = tab->getGraph();
+    // the snapshot only re-checks the blocks changed since the last run
+    auto snapshot = tab->getGraph()->snapshot();
+    auto plan = makePlan(*snapshot, RunOptions());
+    return plan && validityCheck(*snapshot, *plan);
+}
+
+std::optional<codegen::Plan> Kedro::makePlan(const GraphSnapshot &snapshot,
+                                             const RunOptions &options)
+{
+    codegen::Plan plan;
+    std::vector<GraphSnapshot::Index> targets;
+    if (options.targets.empty()) {
+        targets = codegen::sinks(snapshot);
+    } else {
+        // the selection may be of another tab or of blocks deleted since
+        for (const auto &id : options.targets)
+            if (auto index = snapshot.indexOf(id))
+                targets.push_back(*index);
+        if (targets.empty()) {
+            const QString warning = "None of the selected blocks is in the graph to execute";
+            qWarning().noquote() << warning;
+            setValidityWarnings({warning});
+            return std::nullopt;
+        }
+    }
+    // without sinks nothing shows the results, every block is kept
+    if (!targets.empty()) {
+        plan.included = codegen::upstreamClosure(snapshot, targets);
+        // a data source alone has nothing to run, kedro rejects an empty pipeline
+        bool runsAnything = false;
+        for (GraphSnapshot::Index i = 0; i < snapshot.size() && !runsAnything; ++i)
+            runsAnything = plan.included[i] && codegen::isPipelineNode(snapshot.node(i));
+        if (!options.targets.empty() && !runsAnything) {
+            const QString warning = "The selected blocks and the blocks they read from have "
+                                    "nothing to run, select a block that computes";
+            qWarning().noquote() << warning;
+            setValidityWarnings({warning});
+            return std::nullopt;
+        }
+        QStringList skipped;
+        for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i)
+            if (!plan.included[i] && codegen::isPipelineNode(snapshot.node(i)))
+                skipped << snapshot.node(i).caption;
+        const QString reason = options.targets.empty() ? "no sink uses"
+                                                       : "the selected blocks do not need";
+        if (!skipped.isEmpty())
+            qInfo().noquote() << QString("Skipped %1 block(s) that %2: %3")
+                                     .arg(skipped.size())
+                                     .arg(reason, skipped.join(", "));
+        if (std::all_of(plan.included.begin(), plan.included.end(), [](bool b) { return b; }))
+            plan.included.clear();
+    }
+    // copies of a block are computed once, the graph is left for the user to clean up
+    for (const auto &[merged, kept] : codegen::mergeDuplicates(snapshot, plan))
+        qInfo().noquote() << QString("'%1' is identical to '%2', it is computed once")
+                                 .arg(snapshot.node(merged).caption, snapshot.node(kept).caption);
+    // chains of blocks run as one kedro node, skipping the dataset handoffs between them
+    if (Settings::instance().get<bool>("fuse block chains")) {
+        plan.fused = codegen::fusableChains(snapshot, plan);
+        for (const auto &chain : plan.fused)
+            qInfo().noquote() << "Fused blocks:" << codegen::describe(snapshot, chain);
+    }
+    return plan;
+}
+
+bool Kedro::validityCheck(const GraphSnapshot &snapshot, const codegen::Plan &plan)
+{
     qInfo() << "Checking graph validity...";
-    if (graph->isEmpty()) {
+    if (snapshot.isEmpty()) {
         qWarning() << "There is no blocks in the graph to execute";
+        setValidityWarnings({"There is no blocks in the graph to execute"});
         return false;
     }
-    if (!graph->isConnected()) {
-        qWarning() << "The blocks in the graph are not connected";
-        return false;
-    }
-    // Add check that every node input is connected
-    if (!graph->verifyBlocksValidity()) {
-        qWarning() << "Some blocks in the graph are not valid, please check the connections";
+    // report every problem at once, skipped blocks may still be under construction
+    QStringList problems = snapshot.problems(plan.requested());
+    setValidityWarnings(problems);
+    if (!problems.isEmpty()) {
+        for (const auto &problem : problems)
+            qWarning().noquote() << problem;
+        qWarning() << "The graph is not valid," << problems.size() << "problem(s) found";
         return false;
     }
     qInfo() << "Passed validity checks!";
     return true;
 }
 
+QString Kedro::runFingerprint(std::shared_ptr<TabComponents> tab,
+                             const GraphSnapshot &snapshot,
+                             const codegen::Plan &plan) const
+{
+    QTUTILITY_TRACE_SCOPE("run fingerprint");
+    // fusion does not change the results
+    codegen::Plan unfused = plan;
+    unfused.fused.clear();
+    RunCache::Fingerprint fingerprint;
+    fingerprint.add("engine", m_ENGINE_VERSION.toUtf8());
+    fingerprint.add("pipeline", serializePipeline(snapshot, unfused).toUtf8());
+    fingerprint.add("catalog", serializeCatalog(snapshot, plan).toUtf8());
+    fingerprint.add("parameters", serializeParameters(snapshot, plan).toUtf8());
+    if (auto randomState = tab->getRandomState())
+        fingerprint.add("random_state", QByteArray::number(*randomState));
+    if (plan.preview)
+        fingerprint.add("preview", QByteArray::number(plan.preview->rows));
+    // the catalog only names the files, their content is hashed too
+    for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i) {
+        const SnapshotNode &node = snapshot.node(i);
+        if (!node.catalog || !plan.includes(i))
+            continue;
+        const auto &entry = node.catalog.value();
+        QString path;
+        if (node.name == io_names::DATA_SOURCE)
+            path = tab->getDataDir().absoluteFilePath(entry.sourcePath);
+        else if (node.name == io_names::FUNC_SOURCE)
+            path = entry.sourcePath;
+        if (!path.isEmpty() && !fingerprint.addFile(entry.name, path))
+            return QString();
+    }
+    return fingerprint.result();
+}
+
+QStringList Kedro::runOutputs(const GraphSnapshot &snapshot, const codegen::Plan &plan)
+{
+    QStringList outputs;
+    for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i) {
+        const SnapshotNode &node = snapshot.node(i);
+        if (!plan.includes(i))
+            continue;
+        if (node.name == processor_function::SCORE
+            || node.name == processor_function::SENSITIVITY_ANALYSIS)
+            outputs << constants::kedro::REPORTING_PATH + node.caption;
+        else if (node.name == io_names::FUNC_OUT && node.catalog)
+            outputs << constants::kedro::MODELS_PATH + node.catalog->fileName;
+    }
+    return outputs;
+}
+
 QDir Kedro::initWorkspace(std::shared_ptr<TabComponents> tab)
 {
     auto name = tab->getFileInfo().baseName();
@@ -285,6 +580,8 @@ void Kedro::onExecutionFinished(int exitCode, QProcess::ExitStatus exitStatus)
         return;
     }
     m_execution->timer.stop();
+    if (m_execution->traceStart >= 0)
+        trace::record("kedro run", m_execution->traceStart, trace::now());
 
     bool runStatus = (exitStatus == QProcess::NormalExit && exitCode == 0);
     if (exitStatus == QProcess::ExitStatus::CrashExit) {
@@ -295,18 +592,49 @@ void Kedro::onExecutionFinished(int exitCode, QProcess::ExitStatus exitStatus)
 
     auto output = QString::fromUtf8(m_execution->process.readAllStandardOutput());
     auto errorOutput = m_execution->process.readAllStandardError().trimmed();
+    QString importTimes = importTimeReport(errorOutput);
     if (!errorOutput.isEmpty())
         output += "\nERROR LOG:\n" + QString::fromUtf8(errorOutput);
+    output += importTimes;
 
     if (runStatus) {
+        // stored before post processing moves the function outputs out of the project
+        if (!m_execution->runKey.isEmpty())
+            m_runCache.store(m_execution->runKey, m_execution->project, m_execution->outputs);
+        QTUTILITY_TRACE_SCOPE("postExecutionProcess");
         postExecutionProcess();
     }
     qDebug() << "Kedro executed, result is stored in: " << m_execution->project.absolutePath();
+    if (m_execution->plan.preview)
+        output.prepend("PREVIEW RUN on sampled data, the results are not final\n");
     emit executed(output);
     releaseExecution();
     emit finished(runStatus);
 }
 
+void Kedro::onCachedRun()
+{
+    if (!m_execution->inProgress)
+        return;
+    if (!m_runCache.restore(m_execution->runKey, m_execution->project, m_execution->outputs)) {
+        qWarning() << "Cannot restore the cached run, running kedro instead";
+        startRun();
+        return;
+    }
+    m_execution->timer.stop();
+    qInfo() << "Inputs are unchanged since an earlier run, restored its results";
+    {
+        QTUTILITY_TRACE_SCOPE("postExecutionProcess");
+        postExecutionProcess();
+    }
+    emit executed(QString("%1Restored the results of an identical run from %2/%3")
+                      .arg(m_execution->plan.preview ? "PREVIEW RUN, " : "",
+                           m_runCache.root(),
+                           m_execution->runKey));
+    releaseExecution();
+    emit finished(true);
+}
+
 void Kedro::onTimeOut()
 {
     releaseExecution();
@@ -314,9 +642,42 @@ void Kedro::onTimeOut()
     emit finished(false);
 }
 
-QString Kedro::serializeNode(const QtNodes::NodeId &id, CustomGraph *graph) const
+QString Kedro::serializeParameters(const GraphSnapshot &snapshot, const codegen::Plan &plan)
 {
-    return toString(*graph->delegateModel<FdfBlockModel>(id));
+    QStringList parameters;
+    for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i) {
+        const SnapshotNode &node = snapshot.node(i);
+        if (!node.hasParameters || !plan.includes(i))
+            continue;
+        parameters << node.caption + ':';
+        for (auto &pair : node.parameters) {
+            QString value = pair.second;
+            if (plan.preview && pair.first == TorchTrainerModel::MAX_ITER)
+                value = QString::number(std::min(value.toInt(), plan.preview->maxIter));
+            parameters << QString("  %1: %2").arg(pair.first, value);
+        }
+    }
+    return parameters.join("\n");
+}
+
+QString Kedro::serializePipeline(const GraphSnapshot &snapshot, const codegen::Plan &plan)
+{
+    QStringList serializedObjects;
+    for (auto index : snapshot.topologicalOrder()) {
+        const SnapshotNode &node = snapshot.node(index);
+        if (codegen::isPipelineNode(node) && plan.includes(index))
+            serializedObjects.append(toString(node, plan.aliases));
+    }
+    QStringList chains;
+    for (const auto &chain : plan.fused) {
+        QStringList names;
+        for (auto index : chain)
+            names << quote(snapshot.node(index).caption);
+        chains << '[' + names.join(',') + ']';
+    }
+    return constants::kedro::PIPELINE_PY.arg(imports(snapshot, plan),
+                                             serializedObjects.join(",\n"),
+                                             '[' + chains.join(',') + ']');
 }
 
 void Kedro::verifySetup()
@@ -325,17 +686,11 @@ void Kedro::verifySetup()
     qInfo() << "Kedro is ready to execute!";
 }
 
-bool Kedro::generateParametersYml(const QDir &kedroProject, CustomGraph *graph)
+bool Kedro::generateParametersYml(const QDir &kedroProject,
+                                  const GraphSnapshot &snapshot,
+                                  const codegen::Plan &plan)
 {
-    QStringList parameters;
-    for (const auto &id : graph->allNodeIds())
-        if (auto block = graph->delegateModel<FdfBlockModel>(id)) {
-            if (!block->hasParameters())
-                continue;
-            parameters << block->caption() + ':';
-            for (auto &pair : block->getParameters())
-                parameters << QString("  %1: %2").arg(pair.first, pair.second);
-        }
+    QTUTILITY_TRACE_SCOPE("generateParametersYml");
     QDir conf = ensureDirExists(kedroProject.absoluteFilePath(constants::kedro::CONF_PATH));
     //generate parameters.yml
     QFile parametersYml(conf.absoluteFilePath("parameters.yml"));
@@ -344,58 +699,49 @@ bool Kedro::generateParametersYml(const QDir &kedroProject, CustomGraph *graph)
         return false;
     }
     QTextStream out(&parametersYml);
-    out << parameters.join("\n");
+    out << serializeParameters(snapshot, plan);
     parametersYml.close();
     return true;
 }
 
-bool Kedro::generateCatalogYml(const QDir &kedroProject, std::shared_ptr<TabComponents> tab)
+bool Kedro::generateCatalogYml(const QDir &kedroProject,
+                               std::shared_ptr<TabComponents> tab,
+                               const GraphSnapshot &snapshot,
+                               const codegen::Plan &plan)
 {
+    QTUTILITY_TRACE_SCOPE("generateCatalogYml");
     QDir conf = ensureDirExists(kedroProject.absoluteFilePath(constants::kedro::CONF_PATH));
-    auto dataSources = tab->getGraph()->getDataSourceModels();
     QDir rawDataDir = ensureDirExists(
         kedroProject.absoluteFilePath(constants::kedro::RAW_DATA_PATH));
-    QStringList catalogEntries;
-    for (auto data : dataSources) {
-        auto fileName = data->file().fileName();
-        // copy data to raw data dir
-        QFile::copy(tab->getDataDir().absoluteFilePath(fileName),
-                    rawDataDir.absoluteFilePath(fileName));
-        // add external data to catalog.yml
-        // Fetch the name of the data port of the datasourcemodel, and
-        // for compatibility with kedro, replace spaces with underscores.
-        catalogEntries << constants::kedro::CATALOG_YML_ENTRY.arg(data->outPortCaption(),
-                                                                  data->fileTypeString(),
-                                                                  constants::kedro::RAW_DATA_PATH
-                                                                      + fileName);
-    }
-    // add function sources to catalog.yml
-    auto funcSources = tab->getGraph()->getFuncSourceModels();
     QDir modelsDir = ensureDirExists(kedroProject.absoluteFilePath(constants::kedro::MODELS_PATH));
-    for (auto funcSource : funcSources) {
-        if (funcSource->dillPath().isEmpty() || funcSource->file().fileName().isEmpty()) {
-            qWarning() << "FuncSourceModel: .dill or .json missing in archive. Skipping.";
+    for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i) {
+        const SnapshotNode &node = snapshot.node(i);
+        if (!node.catalog || !plan.includes(i))
             continue;
+        const auto &entry = node.catalog.value();
+        if (node.name == io_names::DATA_SOURCE) {
+            // copy data to raw data dir, the entry is named after the data port of the source
+            QString source = tab->getDataDir().absoluteFilePath(entry.sourcePath);
+            QString destination = rawDataDir.absoluteFilePath(entry.fileName);
+            // a copy does not replace the data of an earlier run, which may have been sampled
+            QFile::remove(destination);
+            if (!plan.preview) {
+                QFile::copy(source, destination);
+            } else if (QFileInfo(entry.fileName).suffix().toLower() == "csv") {
+                const auto &sample = plan.preview.value();
+                if (!preview::sampleCsv(source, destination, sample.rows, sample.seed))
+                    return false;
+            } else {
+                qInfo() << "Only csv data is sampled, the preview reads all of" << entry.fileName;
+                QFile::copy(source, destination);
+            }
+        } else if (node.name == io_names::FUNC_SOURCE) {
+            if (entry.sourcePath.isEmpty()) {
+                qWarning() << "FuncSourceModel: .dill or .json missing in archive. Skipping.";
+                continue;
+            }
+            QFile::copy(entry.sourcePath, modelsDir.absoluteFilePath(entry.fileName));
         }
-        auto funcCatalogEntryTag = funcSource->getFileName();
-        QString fileName = funcCatalogEntryTag + ".pkl";
-        QString destinationPath = modelsDir.absoluteFilePath(fileName);
-        QFile::copy(funcSource->dillPath(), destinationPath);
-        catalogEntries << constants::kedro::CATALOG_YML_ENTRY.arg(funcCatalogEntryTag,
-                                                                  funcSource->fileTypeString(),
-                                                                  constants::kedro::MODELS_PATH
-                                                                      + fileName);
-    }
-
-    // add outputs to catalog.yml
-    auto funcOuts = tab->getGraph()->getFuncOutModels();
-    for (auto funcOut : funcOuts) {
-        auto name = funcOut->getFileName();
-        catalogEntries << constants::kedro::CATALOG_YML_ENTRY
-                              .arg(name,
-                                   funcOut->fileTypeString(),
-                                   constants::kedro::MODELS_PATH + name + '.'
-                                       + funcOut->getFileExtenstion());
     }
     //generate catalog.yml
     QFile catalogYml(conf.absoluteFilePath("catalog.yml"));
@@ -404,22 +750,42 @@ bool Kedro::generateCatalogYml(const QDir &kedroProject, std::shared_ptr<TabComp
         return false;
     }
     QTextStream out(&catalogYml);
-    out << catalogEntries.join("\n");
+    out << serializeCatalog(snapshot, plan);
     catalogYml.close();
     return true;
 }
 
-bool Kedro::generatePipelinePy(const QDir &kedroProject, CustomGraph *graph)
+QString Kedro::serializeCatalog(const GraphSnapshot &snapshot, const codegen::Plan &plan)
+{
+    QStringList catalogEntries;
+    for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i) {
+        const SnapshotNode &node = snapshot.node(i);
+        if (!node.catalog || !plan.includes(i))
+            continue;
+        const auto &entry = node.catalog.value();
+        if (node.name == io_names::FUNC_SOURCE && entry.sourcePath.isEmpty())
+            continue;
+        // sources are copied in by generateCatalogYml, outputs are written by kedro
+        QString catalogPath = (node.name == io_names::DATA_SOURCE
+                                   ? constants::kedro::RAW_DATA_PATH
+                                   : constants::kedro::MODELS_PATH)
+                              + entry.fileName;
+        catalogEntries << constants::kedro::CATALOG_YML_ENTRY.arg(entry.name,
+                                                                  entry.fileType,
+                                                                  catalogPath);
+    }
+    return catalogEntries.join("\n");
+}
+
+bool Kedro::generatePipelinePy(const QDir &kedroProject,
+                               const GraphSnapshot &snapshot,
+                               const codegen::Plan &plan)
 {
+    QTUTILITY_TRACE_SCOPE("generatePipelinePy");
     // for some reason dir name char '-' will convert to '_'
     QDir source = ensureDirExists(kedroProject.absoluteFilePath(
         QString(constants::kedro::SOURCE_PATH).arg(kedroProject.dirName().replace('-', '_'))));
-    QStringList serializedObjects;
-    for (const auto &id : graph->topologicalOrder())
-        if (auto block = graph->delegateModel<FdfBlockModel>(id))
-            if (EXCLUDED_TYPES.count(block->type()) < 1)
-                serializedObjects.append(serializeNode(id, graph));
-    QString data = constants::kedro::PIPELINE_PY.arg(serializedObjects.join(",\n"));
+    QString data = serializePipeline(snapshot, plan);
     QFile pipelinePy(source.absoluteFilePath("pipeline.py"));
     if (!pipelinePy.open(QIODevice::WriteOnly | QIODevice::Text)) {
         qCritical() << "Cannot open pipeline.py:" << pipelinePy.errorString();
@@ -444,11 +810,21 @@ QDir Kedro::ensureDirExists(const QString &path)
 
 void Kedro::postExecutionProcess()
 {
+    // only the blocks that were executed have results, the graph may have changed meanwhile
     auto graph = m_execution->tab->getGraph();
-    for (auto &id : graph->allNodeIds()) {
-        postScoreModel(graph, id);
-        postSensitivityAnalysisModel(graph, id);
-        postFuncOutModel(graph, id);
+    const GraphSnapshot &snapshot = *m_execution->snapshot;
+    for (GraphSnapshot::Index i = 0; i < snapshot.size(); ++i) {
+        const SnapshotNode &node = snapshot.node(i);
+        if (!m_execution->plan.includes(i))
+            continue;
+        if (node.name == processor_function::SCORE)
+            postScoreModel(graph, node.id);
+        else if (node.name == processor_function::SENSITIVITY_ANALYSIS)
+            postSensitivityAnalysisModel(graph, node.id);
+        else if (node.name == io_names::FUNC_OUT && m_execution->plan.preview)
+            qInfo() << "Functions trained in a preview are not saved:" << node.caption;
+        else if (node.name == io_names::FUNC_OUT)
+            postFuncOutModel(graph, node.id);
     }
 }
 
@@ -457,6 +833,7 @@ void Kedro::postScoreModel(CustomGraph *graph, const QtNodes::NodeId &id)
     auto score = graph->delegateModel<ScoreModel>(id);
     if (!score)
         return;
+    score->setExecutedPreview(m_execution->plan.preview.has_value());
 
     QDir reportDir(m_execution->project.absoluteFilePath(constants::kedro::REPORTING_PATH)
                    + score->caption());
@@ -489,6 +866,7 @@ void Kedro::postSensitivityAnalysisModel(CustomGraph *graph, const QtNodes::Node
     auto block = graph->delegateModel<SensitivityAnalysisModel>(id);
     if (!block)
         return;
+    block->setExecutedPreview(m_execution->plan.preview.has_value());
 
     QDir reportDir(m_execution->project.absoluteFilePath(constants::kedro::REPORTING_PATH)
                    + block->caption());
@@ -551,6 +929,7 @@ void Kedro::postFuncOutModel(CustomGraph *graph, const QtNodes::NodeId &id)
     metadataFile.close();
 
     // zip the dill file and json file
+    QTUTILITY_TRACE_SCOPE("compress function output");
     QString zipFilePath = saveDir.absoluteFilePath(fileName + ".zip");
     if (!JlCompress::compressFiles(zipFilePath, {dillFilePath, metadataPath})) {
         qWarning() << "FuncOutModel: Failed to compress files into zip:" << zipFilePath;
@@ -564,5 +943,6 @@ void Kedro::postFuncOutModel(CustomGraph *graph, const QtNodes::NodeId &id)
 void Kedro::releaseExecution()
 {
     m_execution->tab.reset();
+    m_execution->snapshot.reset();
     m_execution->inProgress = false;
 }
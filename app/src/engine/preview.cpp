@@ -0,0 +1,51 @@
+#include "engine/preview.hpp"
+
+#include <QDebug>
+#include <QFile>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace preview {
+
+bool sampleCsv(const QString &source, const QString &destination, int rows, quint32 seed)
+{
+    QFile in(source);
+    if (!in.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot open" << source << in.errorString();
+        return false;
+    }
+    QByteArray header = in.readLine();
+    std::vector<QByteArray> lines;
+    while (!in.atEnd()) {
+        QByteArray line = in.readLine();
+        if (!line.trimmed().isEmpty())
+            lines.push_back(std::move(line));
+    }
+
+    QFile out(destination);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot open" << destination << out.errorString();
+        return false;
+    }
+    out.write(header);
+    // selection sampling, mt19937 is the same everywhere unlike the std distributions
+    std::mt19937 generator(seed);
+    size_t remaining = lines.size();
+    size_t needed = std::min(lines.size(), size_t(std::max(rows, 0)));
+    for (const auto &line : lines) {
+        double u = generator() / 4294967296.0;
+        if (remaining * u < needed) {
+            if (!line.endsWith('\n'))
+                out.write(line + '\n');
+            else
+                out.write(line);
+            --needed;
+        }
+        --remaining;
+    }
+    return out.error() == QFileDevice::NoError;
+}
+
+} // namespace preview
@@ -0,0 +1,228 @@
+#include "engine/run_cache.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QStandardPaths>
+
+#include <QtUtility/trace/trace.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr int LOCK_TIMEOUT_MSECS = 10 * 1000;
+constexpr qint64 READ_CHUNK_SIZE = 1 << 20;
+
+// replaces the destination, directories are copied recursively
+bool copyPath(const QString &source, const QString &destination)
+{
+    QFileInfo info(source);
+    if (info.isDir()) {
+        if (!QDir().mkpath(destination))
+            return false;
+        QDir dir(source);
+        for (const auto &entry : dir.entryList(QDir::AllEntries | QDir::NoDotAndDotDot))
+            if (!copyPath(dir.absoluteFilePath(entry), QDir(destination).absoluteFilePath(entry)))
+                return false;
+        return true;
+    }
+    QFile::remove(destination);
+    QDir().mkpath(QFileInfo(destination).absolutePath());
+    return QFile::copy(source, destination);
+}
+
+bool removePath(const QString &path)
+{
+    QFileInfo info(path);
+    if (info.isDir())
+        return QDir(path).removeRecursively();
+    return !info.exists() || QFile::remove(path);
+}
+
+qint64 pathSize(const QString &path)
+{
+    qint64 size = 0;
+    QDirIterator it(path, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+    return size;
+}
+
+} // namespace
+
+RunCache::Fingerprint::Fingerprint()
+    : m_hash(QCryptographicHash::Sha256)
+{}
+
+void RunCache::Fingerprint::add(const QString &label, const QByteArray &data)
+{
+    // the sizes keep differently split inputs from hashing the same
+    m_hash.addData(label.toUtf8() + '\0' + QByteArray::number(data.size()) + '\0');
+    m_hash.addData(data);
+}
+
+bool RunCache::Fingerprint::addFile(const QString &label, const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "RunCache: Cannot read" << path << file.errorString();
+        return false;
+    }
+    m_hash.addData(label.toUtf8() + '\0' + QByteArray::number(file.size()) + '\0');
+    while (!file.atEnd())
+        m_hash.addData(file.read(READ_CHUNK_SIZE));
+    return true;
+}
+
+QString RunCache::Fingerprint::result() const
+{
+    return QString::fromLatin1(m_hash.result().toHex());
+}
+
+RunCache::RunCache(const QString &root, qint64 maxBytes, int maxAgeDays)
+    : m_root(root)
+    , m_maxBytes(maxBytes)
+    , m_maxAgeDays(maxAgeDays)
+{
+    if (!m_root.exists() && !m_root.mkpath("."))
+        qWarning() << "RunCache: Cannot create" << m_root.absolutePath();
+}
+
+QString RunCache::defaultRoot()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/runs";
+}
+
+bool RunCache::contains(const QString &key) const
+{
+    return QFileInfo(entryPath(key)).isDir();
+}
+
+bool RunCache::restore(const QString &key, const QDir &project, const QStringList &paths) const
+{
+    QTUTILITY_TRACE_SCOPE("restore cached run");
+    QLockFile lock(lockPath(key));
+    if (!lock.tryLock(LOCK_TIMEOUT_MSECS)) {
+        qWarning() << "RunCache: Cannot lock" << lock.error() << lockPath(key);
+        return false;
+    }
+    QDir entry(entryPath(key));
+    if (!entry.exists())
+        return false;
+    for (const auto &path : paths) {
+        // stale outputs of an earlier run in the same project must not show up
+        removePath(project.absoluteFilePath(path));
+        if (entry.exists(path)
+            && !copyPath(entry.absoluteFilePath(path), project.absoluteFilePath(path))) {
+            qWarning() << "RunCache: Cannot restore" << path;
+            return false;
+        }
+    }
+    markUsed(key);
+    return true;
+}
+
+bool RunCache::store(const QString &key, const QDir &project, const QStringList &paths)
+{
+    QTUTILITY_TRACE_SCOPE("store run");
+    QLockFile lock(lockPath(key));
+    if (!lock.tryLock(LOCK_TIMEOUT_MSECS)) {
+        qWarning() << "RunCache: Cannot lock" << lock.error() << lockPath(key);
+        return false;
+    }
+    if (contains(key))
+        return true; // another instance ran the same pipeline
+    // filled next to the entry then renamed, a crash never leaves a partial entry behind
+    QString partial = entryPath(key) + ".partial";
+    removePath(partial);
+    for (const auto &path : paths) {
+        if (!project.exists(path))
+            continue;
+        if (!copyPath(project.absoluteFilePath(path), QDir(partial).absoluteFilePath(path))) {
+            qWarning() << "RunCache: Cannot store" << path;
+            removePath(partial);
+            return false;
+        }
+    }
+    QDir().mkpath(partial); // a run without outputs is an entry too
+    if (!QDir().rename(partial, entryPath(key))) {
+        qWarning() << "RunCache: Cannot create entry" << entryPath(key);
+        removePath(partial);
+        return false;
+    }
+    markUsed(key);
+    lock.unlock();
+    evict(key);
+    return true;
+}
+
+void RunCache::evict(const QString &keep)
+{
+    QTUTILITY_TRACE_SCOPE("evict cached runs");
+    struct Entry
+    {
+        QString key;
+        QDateTime used;
+        qint64 size;
+    };
+    std::vector<Entry> entries;
+    for (const auto &key : m_root.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (key.endsWith(".partial"))
+            continue;
+        // entries of older versions have no mark, they count as used when they were created
+        QFileInfo used(usedPath(key));
+        QFileInfo entry(entryPath(key));
+        entries.push_back({key,
+                           used.exists() ? used.lastModified() : entry.lastModified(),
+                           pathSize(entryPath(key))});
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.used > b.used;
+    });
+    const QDateTime oldest = QDateTime::currentDateTime().addDays(-m_maxAgeDays);
+    qint64 kept = 0;
+    for (const auto &entry : entries) {
+        if (entry.key == keep || (entry.used >= oldest && kept + entry.size <= m_maxBytes)) {
+            kept += entry.size;
+            continue;
+        }
+        QLockFile lock(lockPath(entry.key));
+        if (!lock.tryLock(0))
+            continue; // restored or stored right now
+        qInfo() << "RunCache: Evicting" << entry.key << "last used" << entry.used;
+        removePath(entryPath(entry.key));
+        removePath(usedPath(entry.key));
+    }
+}
+
+QString RunCache::entryPath(const QString &key) const
+{
+    return m_root.absoluteFilePath(key);
+}
+
+QString RunCache::lockPath(const QString &key) const
+{
+    return m_root.absoluteFilePath(key + ".lock");
+}
+
+QString RunCache::usedPath(const QString &key) const
+{
+    return m_root.absoluteFilePath(key + ".used");
+}
+
+// the modification time of the mark is the last use of the entry
+void RunCache::markUsed(const QString &key) const
+{
+    QFile mark(usedPath(key));
+    if (!mark.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        qWarning() << "RunCache: Cannot mark" << key << "as used" << mark.errorString();
+    else
+        mark.write(QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs).toUtf8());
+}
@@ -6,18 +6,22 @@
 #include <QDir>
 #include <QFile>
 #include <QTextStream>
+#include <QTimer>
 
+#include <chrono>
 #include <iostream>
 
 #include <QtUtility/file/file.hpp>
 
 namespace {
 
-std::map<QtMsgType, QColor> TYPE_COLOR = {
-    {QtWarningMsg, Qt::yellow},
-    {QtCriticalMsg, Qt::red},
-    {QtFatalMsg, Qt::red},
-};
+constexpr size_t QUEUE_CAPACITY = 8192;
+constexpr size_t MAX_NOT_PRINTED = 1000;
+constexpr size_t MAX_PENDING_DELIVERY = 5000;
+constexpr int DELIVERY_INTERVAL_MSECS = 33; // about 30 panel updates per second
+constexpr auto WAKE_INTERVAL = std::chrono::milliseconds(50);
+constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(250);
+
 std::map<QtMsgType, QString> TYPE_STRING = {
     {QtDebugMsg, "debug"},
     {QtInfoMsg, "info"},
@@ -52,35 +56,30 @@ QFileInfo getLogFile()
 
 void logHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    static QFile logFile(getLogFile().absoluteFilePath());
-    if (!logFile.isOpen()) {
-        logFile.open(QIODevice::Append | QIODevice::Text);
-    }
-    QTextStream out(&logFile);
-
     // use qSetMessagePattern to format
-    auto message = qFormatLogMessage(type, context, msg);
-
-    out << message << "\n";
-    std::cerr << message.toStdString() << std::endl;
-
-    QMetaObject::invokeMethod(&LogManager::instance(),
-                              "appendMessage",
-                              Qt::AutoConnection,
-                              Q_ARG(QString, message),
-                              Q_ARG(QtMsgType, type));
-
-    out.flush();
-
+    LogManager::instance().post(type, qFormatLogMessage(type, context, msg));
     if (type == QtFatalMsg)
         abort();
 }
 
 } // namespace
 
+LogManager::LogManager()
+    : m_originalHandler(nullptr)
+    , m_queue(QUEUE_CAPACITY)
+    , m_dropped(0)
+    , m_running(false)
+    , m_deliveryTimer(new QTimer(this))
+{
+    m_deliveryTimer->setSingleShot(true);
+    m_deliveryTimer->setInterval(DELIVERY_INTERVAL_MSECS);
+    connect(m_deliveryTimer, &QTimer::timeout, this, &LogManager::deliver);
+}
+
 LogManager::~LogManager()
 {
     qInstallMessageHandler(m_originalHandler);
+    stopWriter();
 }
 
 void LogManager::init()
@@ -96,6 +95,7 @@ void LogManager::init()
         "[%{if-debug}debug%{endif}%{if-info}info%{endif}%{if-warning}warning%{endif}%{if-critical}"
         "error%{endif}%{if-fatal}fatal%{endif}]: %{message}");
 #endif
+    startWriter();
     m_originalHandler = qInstallMessageHandler(logHandler);
 }
 
@@ -104,21 +104,160 @@ void LogManager::registerLogPanel(LogPanel *panel)
     if (!m_logPanels.contains(panel)) {
         m_logPanels.push_back(panel);
         if (!m_notPrinted.empty()) {
-            for (auto message : m_notPrinted)
-                panel->appendMessage(message.string, message.color);
+            panel->appendMessages(
+                std::vector<LogPanel::Message>(m_notPrinted.begin(), m_notPrinted.end()));
             m_notPrinted.clear();
         }
     }
 }
 
+void LogManager::post(const QtMsgType &type, const QString &message)
+{
+    if (type == QtFatalMsg || !m_running.load(std::memory_order_acquire)) {
+        // the process is about to abort, everything before it has to reach the file first
+        writeNow(message);
+        return;
+    }
+    if (!m_queue.tryPush({type, message}))
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
 void LogManager::appendMessage(const QString &message, const QtMsgType &type)
 {
-    QColor color;
-    if (TYPE_COLOR.count(type) > 0)
-        color = TYPE_COLOR[type];
+    std::vector<LogPanel::Message> messages = {{message, type}};
+    for (LogPanel *panel : m_logPanels)
+        if (panel)
+            panel->appendMessages(messages);
+    if (m_logPanels.isEmpty()) {
+        m_notPrinted.push_back(messages.front());
+        if (m_notPrinted.size() > MAX_NOT_PRINTED)
+            m_notPrinted.pop_front();
+    }
+}
+
+void LogManager::deliver()
+{
+    std::vector<LogPanel::Message> messages;
+    {
+        std::lock_guard<std::mutex> lock(m_deliveryMutex);
+        messages.assign(std::make_move_iterator(m_delivery.begin()),
+                        std::make_move_iterator(m_delivery.end()));
+        m_delivery.clear();
+    }
+    if (messages.empty())
+        return;
     for (LogPanel *panel : m_logPanels)
         if (panel)
-            panel->appendMessage(message, color);
-    if (m_logPanels.isEmpty())
-        m_notPrinted.push_back({message, color});
+            panel->appendMessages(messages);
+    if (m_logPanels.isEmpty()) {
+        m_notPrinted.insert(m_notPrinted.end(), messages.begin(), messages.end());
+        while (m_notPrinted.size() > MAX_NOT_PRINTED)
+            m_notPrinted.pop_front();
+    }
+}
+
+void LogManager::startWriter()
+{
+    if (m_running.exchange(true))
+        return;
+    m_writer = std::thread(&LogManager::writerLoop, this);
+}
+
+void LogManager::stopWriter()
+{
+    if (!m_running.exchange(false))
+        return;
+    m_wake.notify_one();
+    // a fatal message logged by the writer itself cannot wait for it
+    if (m_writer.get_id() == std::this_thread::get_id())
+        m_writer.detach();
+    else
+        m_writer.join();
+    // a producer that saw the writer running may have pushed after its last drain, the writer
+    // is done so this thread is the only consumer left
+    LogEntry entry;
+    while (m_queue.tryPop(entry))
+        writeNow(entry.message);
+}
+
+void LogManager::writerLoop()
+{
+    QFile logFile(getLogFile().absoluteFilePath());
+    if (!logFile.open(QIODevice::Append | QIODevice::Text))
+        std::cerr << "Cannot open log file " << logFile.fileName().toStdString() << '\n';
+    QTextStream out(&logFile);
+    std::vector<LogPanel::Message> batch;
+    auto lastFlush = std::chrono::steady_clock::now();
+    bool unflushed = false;
+    bool running = true;
+    while (running) {
+        // read before draining, so messages queued before stopWriter() are still written
+        running = m_running.load(std::memory_order_acquire);
+        LogEntry entry;
+        while (m_queue.tryPop(entry)) {
+            out << entry.message << "\n";
+            std::cerr << entry.message.toStdString() << '\n';
+            batch.push_back({std::move(entry.message), entry.type});
+            unflushed = true;
+        }
+        if (size_t dropped = m_dropped.exchange(0, std::memory_order_relaxed)) {
+            QString message = QString("[log] %1 messages dropped, the log queue was full.")
+                                  .arg(dropped);
+            out << message << "\n";
+            std::cerr << message.toStdString() << '\n';
+            batch.push_back({message, QtWarningMsg});
+            unflushed = true;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (unflushed && (!running || now - lastFlush >= FLUSH_INTERVAL)) {
+            out.flush();
+            std::cerr.flush();
+            lastFlush = now;
+            unflushed = false;
+        }
+        if (!batch.empty())
+            queueDelivery(batch);
+        if (running) {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait_for(lock, WAKE_INTERVAL, [this]() {
+                return !m_running.load(std::memory_order_acquire);
+            });
+        }
+    }
+}
+
+void LogManager::queueDelivery(std::vector<LogPanel::Message> &batch)
+{
+    bool schedule;
+    {
+        std::lock_guard<std::mutex> lock(m_deliveryMutex);
+        schedule = m_delivery.empty();
+        m_delivery.insert(m_delivery.end(),
+                          std::make_move_iterator(batch.begin()),
+                          std::make_move_iterator(batch.end()));
+        // the panel falls behind on bursts, the log file still has every message
+        while (m_delivery.size() > MAX_PENDING_DELIVERY)
+            m_delivery.pop_front();
+    }
+    batch.clear();
+    // one event per frame at most, the timer coalesces everything written meanwhile
+    if (schedule)
+        QMetaObject::invokeMethod(
+            this,
+            [this]() {
+                if (!m_deliveryTimer->isActive())
+                    m_deliveryTimer->start();
+            },
+            Qt::QueuedConnection);
+}
+
+void LogManager::writeNow(const QString &message)
+{
+    stopWriter();
+    QFile logFile(getLogFile().absoluteFilePath());
+    if (logFile.open(QIODevice::Append | QIODevice::Text)) {
+        QTextStream out(&logFile);
+        out << message << "\n";
+    }
+    std::cerr << message.toStdString() << std::endl;
 }
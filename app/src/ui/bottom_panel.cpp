@@ -1,6 +1,5 @@
 #include "ui/bottom_panel.hpp"
 
-#include <QFontDatabase>
 #include <QHBoxLayout>
 #include <QPushButton>
 #include <QStackedWidget>
@@ -37,9 +36,5 @@ BottomPanel::BottomPanel()
 
 void BottomPanel::appendOutputPanel(const QString &text)
 {
-    auto f = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-    f.setPointSize(12);
-    m_outputPanel->setFont(f);
-    m_outputPanel->appendPlainText(text);
-    m_outputPanel->setLineWrapMode(QPlainTextEdit::NoWrap);
+    m_outputPanel->appendText(text);
 }
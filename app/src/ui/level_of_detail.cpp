@@ -0,0 +1,61 @@
+#include "ui/level_of_detail.hpp"
+
+#include <QGraphicsProxyWidget>
+#include <QTimer>
+
+#include <QtNodes/GraphicsView>
+#include <QtNodes/NodeDelegateModel>
+
+#include "data/custom_graph.hpp"
+
+namespace {
+// under this zoom the block captions and widgets are no longer readable
+constexpr double DETAIL_SCALE_THRESHOLD = 0.5;
+} // namespace
+
+LevelOfDetail::LevelOfDetail(CustomGraph *graph, QtNodes::GraphicsView *view)
+    : QObject(view)
+    , m_graph(graph)
+    , m_view(view)
+    , m_detailed(view->transform().m11() >= DETAIL_SCALE_THRESHOLD)
+{
+    for (auto id : graph->allNodeIds())
+        m_nodes.insert(id);
+    connect(m_view, &QtNodes::GraphicsView::scaleChanged, this, &LevelOfDetail::onScaleChanged);
+    // the graphics object of a node is created by the scene, style it once it exists
+    connect(graph, &CustomGraph::nodeCreated, this, [this](QtNodes::NodeId id) {
+        m_nodes.insert(id);
+        if (!m_detailed)
+            QTimer::singleShot(0, this, [this, id]() {
+                if (m_nodes.count(id) > 0)
+                    apply(id);
+            });
+    });
+    connect(graph, &CustomGraph::nodeDeleted, this, [this](QtNodes::NodeId id) {
+        m_nodes.erase(id);
+    });
+}
+
+void LevelOfDetail::onScaleChanged(double scale)
+{
+    bool detailed = scale >= DETAIL_SCALE_THRESHOLD;
+    if (detailed == m_detailed)
+        return;
+    m_detailed = detailed;
+    for (auto id : m_nodes)
+        apply(id);
+}
+
+void LevelOfDetail::apply(QtNodes::NodeId id)
+{
+    // the scene embeds the widget of a block as a proxy child of its node graphics object
+    auto model = m_graph->delegateModel<QtNodes::NodeDelegateModel>(id);
+    QWidget *widget = model ? model->embeddedWidget() : nullptr;
+    QGraphicsProxyWidget *proxy = widget ? widget->graphicsProxyWidget() : nullptr;
+    if (!proxy)
+        return;
+    proxy->setVisible(m_detailed);
+    if (auto node = proxy->parentItem())
+        node->setCacheMode(m_detailed ? QGraphicsItem::DeviceCoordinateCache
+                                      : QGraphicsItem::ItemCoordinateCache);
+}
@@ -1,28 +1,19 @@
 #include "ui/log_panel.hpp"
 
 #include "log_manager.hpp"
-#include <QApplication>
-#include <QFontDatabase>
 
 LogPanel::LogPanel(QWidget *parent)
-    : QPlainTextEdit(parent)
-    , m_DEFAULT_TEXT_COLOR(QApplication::palette().text().color())
+    : LogView(parent)
 {
-    setReadOnly(true);
     LogManager::instance().registerLogPanel(this);
 }
 
-void LogPanel::appendMessage(const QString &text, const QColor &color)
+void LogPanel::appendMessage(const QString &text, const QtMsgType &type)
 {
-    auto f = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-    f.setPointSize(12);
-    setFont(f);
-    setLineWrapMode(QPlainTextEdit::NoWrap);
-    QTextCharFormat format = currentCharFormat();
-    format.setForeground(QBrush(color.isValid() ? color : m_DEFAULT_TEXT_COLOR));
-    auto cursor = textCursor();
-    cursor.clearSelection();
-    setTextCursor(cursor);
-    setCurrentCharFormat(format);
-    appendPlainText(text);
-}
\ No newline at end of file
+    appendLines({{text, type}});
+}
+
+void LogPanel::appendMessages(const std::vector<Message> &messages)
+{
+    appendLines(messages);
+}
@@ -0,0 +1,262 @@
+#include "ui/log_view.hpp"
+
+#include <QAction>
+#include <QApplication>
+#include <QClipboard>
+#include <QComboBox>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QScrollBar>
+#include <QTableView>
+#include <QTimer>
+#include <QToolButton>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <map>
+
+namespace {
+constexpr int FILTER_DELAY_MSECS = 200;
+
+const std::map<QtMsgType, QColor> TYPE_COLOR = {
+    {QtWarningMsg, Qt::yellow},
+    {QtCriticalMsg, Qt::red},
+    {QtFatalMsg, Qt::red},
+};
+
+// QtMsgType values are not ordered by severity
+int severity(const QtMsgType &type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return 0;
+    case QtInfoMsg:
+        return 1;
+    case QtWarningMsg:
+        return 2;
+    case QtCriticalMsg:
+        return 3;
+    case QtFatalMsg:
+        return 4;
+    }
+    return 1;
+}
+} // namespace
+
+LogModel::LogModel(QObject *parent)
+    : QAbstractListModel(parent)
+{}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+    return m_filtered ? int(m_rows.size()) : int(m_shown);
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+    size_t line = lineAt(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return m_store.line(line);
+    case Qt::ForegroundRole: {
+        auto it = TYPE_COLOR.find(m_store.type(line));
+        if (it != TYPE_COLOR.end())
+            return it->second;
+        break;
+    }
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+void LogModel::append(const std::vector<Line> &lines)
+{
+    size_t first = m_store.size();
+    for (const auto &line : lines)
+        m_store.append(line.text, line.type);
+    size_t last = m_store.size();
+    if (!m_filtered) {
+        if (last == first)
+            return;
+        beginInsertRows(QModelIndex(), int(first), int(last - 1));
+        m_shown = last;
+        endInsertRows();
+        return;
+    }
+    std::vector<quint32> matches;
+    for (size_t i = first; i < last; ++i)
+        if (accepted(i))
+            matches.push_back(quint32(i));
+    m_shown = last;
+    if (matches.empty())
+        return;
+    int row = int(m_rows.size());
+    beginInsertRows(QModelIndex(), row, row + int(matches.size()) - 1);
+    m_rows.insert(m_rows.end(), matches.begin(), matches.end());
+    endInsertRows();
+}
+
+void LogModel::setFilter(const QString &text, const QtMsgType &minimumType)
+{
+    beginResetModel();
+    m_filterText = text.toUtf8();
+    m_minimumSeverity = severity(minimumType);
+    m_filtered = !m_filterText.isEmpty() || m_minimumSeverity > severity(QtDebugMsg);
+    m_rows.clear();
+    if (m_filtered) {
+        for (size_t i = 0; i < m_store.size(); ++i)
+            if (accepted(i))
+                m_rows.push_back(quint32(i));
+    }
+    m_shown = m_store.size();
+    endResetModel();
+}
+
+int LogModel::find(const QString &text, int from, bool backward) const
+{
+    QByteArray needle = text.toUtf8();
+    int count = rowCount();
+    if (needle.isEmpty() || count == 0)
+        return -1;
+    if (from < 0)
+        from = backward ? count : -1;
+    for (int step = 1; step <= count; ++step) {
+        int row = ((from + (backward ? -step : step)) % count + count) % count;
+        if (m_store.contains(lineAt(row), needle))
+            return row;
+    }
+    return -1;
+}
+
+void LogModel::clear()
+{
+    beginResetModel();
+    m_store.clear();
+    m_rows.clear();
+    m_shown = 0;
+    endResetModel();
+}
+
+bool LogModel::accepted(size_t line) const
+{
+    if (severity(m_store.type(line)) < m_minimumSeverity)
+        return false;
+    return m_filterText.isEmpty() || m_store.contains(line, m_filterText);
+}
+
+LogView::LogView(QWidget *parent)
+    : QWidget(parent)
+    , m_model(new LogModel(this))
+    , m_view(new QTableView)
+    , m_filterEdit(new QLineEdit)
+    , m_typeBox(new QComboBox)
+    , m_searchEdit(new QLineEdit)
+{
+    auto f = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    f.setPointSize(12);
+    m_view->setFont(f);
+    m_view->setModel(m_model);
+    m_view->setShowGrid(false);
+    m_view->setWordWrap(false);
+    m_view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->horizontalHeader()->hide();
+    m_view->horizontalHeader()->setStretchLastSection(true);
+    // fixed row heights keep scrolling and appends independent of the number of lines
+    m_view->verticalHeader()->hide();
+    m_view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_view->verticalHeader()->setDefaultSectionSize(QFontMetrics(f).height() + 2);
+
+    auto copyAction = new QAction(this);
+    copyAction->setShortcut(QKeySequence::Copy);
+    copyAction->setShortcutContext(Qt::WidgetShortcut);
+    m_view->addAction(copyAction);
+    connect(copyAction, &QAction::triggered, this, [this]() {
+        QStringList lines;
+        auto rows = m_view->selectionModel()->selectedRows();
+        std::sort(rows.begin(), rows.end());
+        for (const auto &index : rows)
+            lines << index.data().toString();
+        QApplication::clipboard()->setText(lines.join('\n'));
+    });
+
+    m_filterEdit->setPlaceholderText("Filter");
+    m_filterEdit->setClearButtonEnabled(true);
+    m_typeBox->addItem("All", int(QtDebugMsg));
+    m_typeBox->addItem("Info", int(QtInfoMsg));
+    m_typeBox->addItem("Warnings", int(QtWarningMsg));
+    m_typeBox->addItem("Errors", int(QtCriticalMsg));
+    m_searchEdit->setPlaceholderText("Search");
+    m_searchEdit->setClearButtonEnabled(true);
+    auto previousButton = new QToolButton;
+    previousButton->setArrowType(Qt::UpArrow);
+    previousButton->setToolTip("Previous match");
+    auto nextButton = new QToolButton;
+    nextButton->setArrowType(Qt::DownArrow);
+    nextButton->setToolTip("Next match");
+
+    auto toolLayout = new QHBoxLayout;
+    toolLayout->setContentsMargins(0, 0, 0, 0);
+    toolLayout->addWidget(m_filterEdit);
+    toolLayout->addWidget(m_typeBox);
+    toolLayout->addStretch();
+    toolLayout->addWidget(m_searchEdit);
+    toolLayout->addWidget(previousButton);
+    toolLayout->addWidget(nextButton);
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(2);
+    layout->addLayout(toolLayout);
+    layout->addWidget(m_view);
+
+    // filtering scans the whole store, wait until the user stops typing
+    auto filterTimer = new QTimer(this);
+    filterTimer->setSingleShot(true);
+    filterTimer->setInterval(FILTER_DELAY_MSECS);
+    connect(filterTimer, &QTimer::timeout, this, &LogView::applyFilter);
+    connect(m_filterEdit, &QLineEdit::textChanged, filterTimer, qOverload<>(&QTimer::start));
+    connect(m_typeBox, &QComboBox::currentIndexChanged, this, &LogView::applyFilter);
+    connect(m_searchEdit, &QLineEdit::returnPressed, this, [this]() { search(false); });
+    connect(nextButton, &QToolButton::clicked, this, [this]() { search(false); });
+    connect(previousButton, &QToolButton::clicked, this, [this]() { search(true); });
+}
+
+void LogView::appendLines(const std::vector<LogModel::Line> &lines)
+{
+    auto scrollBar = m_view->verticalScrollBar();
+    bool atBottom = scrollBar->value() == scrollBar->maximum();
+    m_model->append(lines);
+    // follow the output unless the user scrolled up
+    if (atBottom)
+        m_view->scrollToBottom();
+}
+
+void LogView::clear()
+{
+    m_model->clear();
+}
+
+void LogView::applyFilter()
+{
+    m_model->setFilter(m_filterEdit->text(), QtMsgType(m_typeBox->currentData().toInt()));
+    m_view->scrollToBottom();
+}
+
+void LogView::search(bool backward)
+{
+    int from = m_view->currentIndex().isValid() ? m_view->currentIndex().row() : -1;
+    int row = m_model->find(m_searchEdit->text(), from, backward);
+    if (row < 0)
+        return;
+    auto index = m_model->index(row);
+    m_view->setCurrentIndex(index);
+    m_view->scrollTo(index, QAbstractItemView::PositionAtCenter);
+}
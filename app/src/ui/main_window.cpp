@@ -4,6 +4,8 @@
 #include <QApplication>
 #include <QDir>
 #include <QDockWidget>
+#include <QFile>
+#include <QFileDialog>
 #include <QLabel>
 #include <QMenuBar>
 #include <QMessageBox>
@@ -23,6 +25,7 @@ using QtNodes::GraphicsViewStyle;
 using QtNodes::NodeStyle;
 
 #include <QtUtility/media/media.hpp>
+#include <QtUtility/trace/trace.hpp>
 
 #include "data/block_manager.hpp"
 #include "data/constants.hpp"
@@ -76,6 +79,7 @@ MainWindow::~MainWindow()
                &BlockManager::nodeSelected,
                this,
                &MainWindow::onBlockSelected);
+    m_blocks->flushParameters();
     m_tabManager->clear();
     qInfo() << "Program has finished.";
 }
@@ -92,6 +96,12 @@ bool MainWindow::executeDCB()
 
 bool MainWindow::callExecute()
 {
+    return execute(RunOptions());
+}
+
+bool MainWindow::execute(const RunOptions &options)
+{
+    m_blocks->flushParameters();
     auto currentTab = m_tabManager->getCurrentTab();
     if (!currentTab) {
         qWarning() << "No tab to execute";
@@ -100,7 +110,7 @@ bool MainWindow::callExecute()
     if (!validateTab(currentTab)) {
         return false;
     }
-    return m_engine->execute(currentTab);
+    return m_engine->execute(currentTab, options);
 }
 
 bool MainWindow::validateTab(std::shared_ptr<TabComponents> &tab)
@@ -193,6 +203,21 @@ void MainWindow::scoreParameters(const QString &scoreParameters)
     emit scoreParams(scoreParameters);
 }
 
+void MainWindow::startTrace()
+{
+    // leftovers of the previous session would be merged into this one
+    for (const auto &file : m_engine->traceEventFiles())
+        QFile::remove(file);
+    QtUtility::trace::setEnabled(true);
+    qInfo() << "Recording trace";
+}
+
+bool MainWindow::writeTrace(const QString &path)
+{
+    QtUtility::trace::setEnabled(false);
+    return QtUtility::trace::writeChromeTrace(path, m_engine->traceEventFiles());
+}
+
 void MainWindow::initMenuBar()
 {
     auto menuBar = new QMenuBar();
@@ -212,6 +237,14 @@ void MainWindow::initMenuBar()
     previousTabAction->setDisabled(true);
     fileMenu->addSeparator();
     auto runAction = fileMenu->addAction("Run");
+    auto runSelectedAction = fileMenu->addAction("Run to Selected Blocks");
+    auto previewAction = fileMenu->addAction("Preview Run");
+    fileMenu->addSeparator();
+    auto traceAction = fileMenu->addAction("Record Trace");
+    traceAction->setCheckable(true);
+
+    QMenu *editMenu = menuBar->addMenu("Edit");
+    auto undoOverrideAction = editMenu->addAction("Undo Type Override");
 
     newAction->setShortcuts({QKeySequence::New, QKeySequence::AddTab});
     saveAction->setShortcut(QKeySequence::Save);
@@ -222,10 +255,19 @@ void MainWindow::initMenuBar()
     previousTabAction->setShortcut(
         QKeyCombination(Qt::MetaModifier | Qt::ShiftModifier, Qt::Key_Tab));
     runAction->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_R));
+    runSelectedAction->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_R));
+    previewAction->setShortcut(QKeySequence(Qt::CTRL | Qt::ALT | Qt::Key_R));
 
     connect(newAction, &QAction::triggered, m_tabManager.get(), &TabManager::newTab);
-    connect(saveAction, &QAction::triggered, m_tabManager.get(), &TabManager::save);
-    connect(saveAsAction, &QAction::triggered, m_tabManager.get(), &TabManager::saveAs);
+    // parameter edits are applied once the user pauses, the file gets the latest ones
+    connect(saveAction, &QAction::triggered, this, [this]() {
+        m_blocks->flushParameters();
+        m_tabManager->save();
+    });
+    connect(saveAsAction, &QAction::triggered, this, [this]() {
+        m_blocks->flushParameters();
+        m_tabManager->saveAs();
+    });
     connect(openAction, &QAction::triggered, m_tabManager.get(), &TabManager::open);
     connect(closeAction,
             &QAction::triggered,
@@ -249,6 +291,34 @@ void MainWindow::initMenuBar()
                 previousTabAction->setEnabled(MORE_THAN_ONE);
             });
     connect(runAction, &QAction::triggered, this, &MainWindow::callExecute);
+    connect(runSelectedAction, &QAction::triggered, this, [this]() {
+        execute(RunOptions{m_blockManager->selectedNodes()});
+    });
+    connect(previewAction, &QAction::triggered, this, [this]() {
+        RunOptions options;
+        options.preview = true;
+        execute(options);
+    });
+    connect(undoOverrideAction, &QAction::triggered, this, []() {
+        auto uidManager = TabManager::getUIDManager();
+        if (!uidManager || !uidManager->undoLastOverride())
+            qInfo() << "No type override to undo.";
+    });
+    connect(traceAction, &QAction::toggled, this, [this](bool checked) {
+        if (checked) {
+            startTrace();
+            return;
+        }
+        QString path = QFileDialog::getSaveFileName(this,
+                                                    "Save Trace",
+                                                    QDir::home().filePath("trace.json"),
+                                                    "Chrome Trace (*.json)");
+        if (path.isEmpty()) {
+            QtUtility::trace::setEnabled(false);
+            return;
+        }
+        writeTrace(path);
+    });
 
 #ifdef DEBUG
     { // temp menu for testing code
@@ -299,7 +369,7 @@ void MainWindow::initPrimarySideBar()
         {SideBarAction::Blocks,
          QtUtility::media::recolor(QIcon(":/blocks.png"), iconColor),
          "Box",
-         new Blocks(m_blockManager, m_tabManager)},
+         m_blocks = new Blocks(m_blockManager, m_tabManager)},
         {SideBarAction::Charts,
          QtUtility::media::recolor(QIcon(":/charts.png"), iconColor),
          "Charts",
@@ -1,5 +1,6 @@
 #include "ui/models/fdf_block_model.hpp"
 #include "data/constants.hpp"
+#include "data/custom_graph.hpp"
 #include "data/tab_manager.hpp"
 #include <QAbstractButton>
 #include <QFileInfo>
@@ -96,19 +97,26 @@ QWidget *FdfBlockModel::embeddedWidget()
     return m_label;
 }
 
-bool FdfBlockModel::checkBlockValidity() const
+QStringList FdfBlockModel::validityProblems() const
 {
     // check if all input ports are connected.
-    int index = 0;
-    for (const auto &portPair : m_inPorts) {
-        if (!portPair.second.lock()) {
-            qWarning() << "Input port at index " << index << " of block " << this->caption()
-                       << " is not connected.";
-            return false;
-        }
-        index++;
-    }
-    return true;
+    QStringList problems;
+    for (PortIndex index = 0; index < m_inPorts.size(); ++index)
+        if (!m_inPorts.at(index).second.lock())
+            problems << QString("Input port %1 is not connected.").arg(index);
+    return problems;
+}
+
+void FdfBlockModel::setValidityProblems(const QStringList &problems)
+{
+    if (m_validityProblems == problems)
+        return;
+    m_validityProblems = problems;
+    auto style = nodeStyle();
+    style.NormalBoundaryColor = problems.isEmpty() ? m_boundaryColor : style.ErrorColor;
+    setNodeStyle(style);
+    if (auto widget = embeddedWidget())
+        widget->setToolTip(problems.join('\n'));
 }
 
 QString FdfBlockModel::portCaption(PortType portType, PortIndex portIndex) const
@@ -301,10 +309,19 @@ bool FdfBlockModel::indexCheck(PortType type, PortIndex index) const
 
 void FdfBlockModel::propagateUpdate()
 {
+    // inside a graph update, the graph propagates the block once on commit
+    if (m_graph && m_graph->deferPropagation(m_nodeId))
+        return;
     for (uint i = 0; i < nPorts(PortType::Out); ++i)
         emit dataUpdated(i);
 }
 
+void FdfBlockModel::setGraph(CustomGraph *graph, const QtNodes::NodeId &nodeId)
+{
+    m_graph = graph;
+    m_nodeId = nodeId;
+}
+
 void FdfBlockModel::setCaption(const QString &caption)
 {
     if (m_caption == caption)
@@ -416,6 +433,12 @@ QStringList FdfBlockModel::getParameterOptions(const QString &key) const
 
 void FdfBlockModel::setParameter(const QString &key, const QString &value) {}
 
+void FdfBlockModel::updateParameter(const QString &key, const QString &value)
+{
+    setParameter(key, value);
+    emit parameterUpdated(key);
+}
+
 unsigned int FdfBlockModel::nPorts(const PortType &portType, const QString &typeId) const
 {
     uint result = 0;
@@ -452,6 +475,14 @@ void FdfBlockModel::setExecutedGraphs(const QStringList &paths)
     emit contentUpdated();
 }
 
+void FdfBlockModel::setExecutedPreview(bool preview)
+{
+    if (m_executedPreview == preview)
+        return;
+    m_executedPreview = preview;
+    emit contentUpdated();
+}
+
 bool FdfBlockModel::canConnect(ConnectionInfo &connInfo) const
 {
     return true;
@@ -561,6 +592,7 @@ bool FdfBlockModel::handleSignatureMismatch(std::vector<FdfUID> expectedTypes,
 void FdfBlockModel::updateStyle()
 {
     auto style = nodeStyle();
+    m_boundaryColor = style.NormalBoundaryColor;
     switch (m_type) {
     case FdfType::Coder:
         style.GradientColor1 = constants::COLOR_CODER;
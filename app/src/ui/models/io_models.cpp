@@ -1,14 +1,18 @@
 #include "ui/models/io_models.hpp"
+#include "data/func_archive_index.hpp"
 #include "data/tab_manager.hpp"
 #include "ui/models/function_names.hpp"
-#include <quazip/JlCompress.h>
 
-#include <QJsonArray>
+#include <QFile>
 #include <QLabel>
 #include <QPushButton>
 #include <QStandardPaths>
 #include <QVBoxLayout>
 
+#include <QtUtility/media/image_loader.hpp>
+
+using ImageLoader = QtUtility::media::ImageLoader;
+
 namespace {
 
 std::unordered_map<CatalogType, QString> CATALOG_STRING = {
@@ -128,14 +132,12 @@ QString DataSourceModel::outPortCaption()
     return "";
 }
 
-bool DataSourceModel::checkBlockValidity() const
+QStringList DataSourceModel::validityProblems() const
 {
     // Check if the file is set and has a valid type
-    if (m_file.fileName().isEmpty()) {
-        qWarning() << "DataSourceModel: No file set.";
-        return false;
-    }
-    return true;
+    if (m_file.fileName().isEmpty())
+        return {"No file set."};
+    return {};
 }
 
 FuncSourceModel::FuncSourceModel()
@@ -196,98 +198,29 @@ void FuncSourceModel::setFile(const QFileInfo &file)
     m_file = file;
 
     auto dataDir = TabManager::instance().getCurrentTab()->getDataDir();
-    auto tmpDir = TabManager::instance().getCurrentTab()->getTempDir();
     QString zipPath = dataDir.filePath(m_file.fileName());
     if (!QFile::exists(zipPath)) {
         return;
     }
 
     // keep the dataDir clean, as it finally is compressed into the dcb file
-    // so, unzip into the tmpDir
-    // extract only the light-weight json from the zip into tempUnzipDir
-    // to create unique "func_unzip_filehash" folder. Here is
-    // where the full zip is extracted. The tempUnzipDir is deleted
-    // after full extraction to keep the tmpDir clean
-    QStringList filesInZip = JlCompress::getFileList(zipPath);
-    QString jsonFileName;
-    for (const QString &f : filesInZip) {
-        if (f.endsWith(".json")) {
-            jsonFileName = f;
-            break;
-        }
-    }
-    if (jsonFileName.isEmpty()) {
-        qWarning() << "FuncSourceModel: No JSON metadata found in archive.";
-        return;
-    }
-    QString tempFolder = tmpDir->filePath(QString("func_unzip_tmp"));
-    QDir tempUnzipDir(tempFolder);
-    if (tempUnzipDir.exists())
-        tempUnzipDir.removeRecursively();
-    tempUnzipDir.mkpath(".");
-    QStringList extractedJson = JlCompress::extractFiles(zipPath,
-                                                         {jsonFileName},
-                                                         tempUnzipDir.absolutePath());
-    if (extractedJson.isEmpty()) {
-        qWarning() << "FuncSourceModel: Failed to extract JSON metadata.";
-        return;
-    }
-
-    QFile jsonFile(extractedJson.first());
-    if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "FuncSourceModel: Failed to read metadata json.";
-        return;
-    }
-    QJsonDocument doc = QJsonDocument::fromJson(jsonFile.readAll());
-    if (!doc.isObject()) {
-        qWarning() << "FuncSourceModel: Invalid JSON format.";
-        return;
-    }
-    QJsonObject meta = doc.object();
-    QString fileHash = meta["file_hash"].toString().trimmed();
-    if (fileHash.isEmpty()) {
-        qWarning() << "FuncSourceModel: file_hash missing in metadata.";
-        return;
-    }
-
-    QString hashFolderPath = tmpDir->filePath(QString("func_unzip_%1").arg(fileHash));
-    QDir hashDir(hashFolderPath);
-    if (!hashDir.exists())
-        hashDir.mkpath(".");
-
-    QStringList unzippedFiles = JlCompress::extractDir(zipPath, hashDir.absolutePath());
-    if (unzippedFiles.isEmpty()) {
-        qWarning() << "FuncSourceModel: Archive extraction failed.";
-        return;
-    }
-    QString dillPath;
-    for (const QString &path : unzippedFiles) {
-        if (path.endsWith(".pkl")) {
-            dillPath = path;
-            break;
-        }
-    }
-    if (dillPath.isEmpty()) {
-        qWarning() << "FuncSourceModel: .pkl missing in archive.";
-        return;
-    }
-    m_dillPath = dillPath;
-
-    QJsonObject sig = meta["function_signature"].toObject();
-    if (sig.isEmpty() || sig["input"].toArray().isEmpty() || sig["output"].toArray().isEmpty()) {
-        qWarning() << "FuncSourceModel: Invalid or missing function signature in metadata.";
+    // so, the archive is indexed and unzipped into the shared cache folder
+    auto archive = FuncArchiveIndex::instance().load(zipPath);
+    if (!archive) {
+        qWarning() << "FuncSourceModel: Failed to import" << zipPath;
         return;
     }
+    m_dillPath = archive->dillPath;
 
     auto uidManager = TabManager::getUIDManager();
     auto remapUID = [&](int original) -> FdfUID {
-        return uidManager->getOrCreateUIDOnFuncLoad(fileHash, original);
+        return uidManager->getOrCreateUIDOnFuncLoad(archive->fileHash, original);
     };
     std::vector<FdfUID> newInputs, newOutputs;
-    for (const QJsonValue &val : sig["input"].toArray())
-        newInputs.push_back(remapUID(val.toInt()));
-    for (const QJsonValue &val : sig["output"].toArray())
-        newOutputs.push_back(remapUID(val.toInt()));
+    for (int id : archive->inputs)
+        newInputs.push_back(remapUID(id));
+    for (int id : archive->outputs)
+        newOutputs.push_back(remapUID(id));
     Signature signature{newInputs, newOutputs};
 
     addPort<FunctionNode>(PortType::Out);
@@ -297,9 +230,6 @@ void FuncSourceModel::setFile(const QFileInfo &file)
         return;
     }
 
-    // clean up temp dir
-    if (tempUnzipDir.exists())
-        tempUnzipDir.removeRecursively();
     port->setSignature(signature);
     port->setName(m_file.baseName());
     emit contentUpdated();
@@ -318,14 +248,12 @@ QString FuncSourceModel::getFileName() const
     return portCaption(PortType::Out, 0);
 }
 
-bool FuncSourceModel::checkBlockValidity() const
+QStringList FuncSourceModel::validityProblems() const
 {
     // Check if the file is set and has a valid type
-    if (m_file.fileName().isEmpty()) {
-        qWarning() << "FunctionSourceModel: No file set.";
-        return false;
-    }
-    return true;
+    if (m_file.fileName().isEmpty())
+        return {"No file set."};
+    return {};
 }
 
 FuncOutModel::FuncOutModel()
@@ -441,16 +369,22 @@ QWidget *GraphModel::embeddedWidget()
     if (!m_graph) {
         m_graph = new QLabel;
         m_graph->setStyleSheet("QLabel{ background: transparent; }");
-        if (!m_file.absoluteFilePath().isEmpty())
-            m_graph->setPixmap(QPixmap(m_file.absoluteFilePath()));
+        updateGraph();
     }
     return m_graph;
 }
 
 void GraphModel::updateGraph()
 {
-    if (!m_graph)
+    QString path = m_file.absoluteFilePath();
+    if (!m_graph || path.isEmpty())
         return;
-    m_graph->setPixmap(QPixmap(m_file.absoluteFilePath()));
-    emit contentUpdated();
+    // the graph is decoded in the background and shown once loaded
+    ImageLoader::instance().request(path, QSize(), this, [this, path](const QImage &image) {
+        // another file may have been set while this one was decoded
+        if (!m_graph || image.isNull() || path != m_file.absoluteFilePath())
+            return;
+        m_graph->setPixmap(QPixmap::fromImage(image));
+        emit contentUpdated();
+    });
 }
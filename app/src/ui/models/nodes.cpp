@@ -24,8 +24,7 @@ DataNode::DataNode(FdfUID typeId)
     : NamedNode("data")
 {
     m_type.id = constants::DATA_PORT_ID;
-    auto uidManager = TabManager::getUIDManager();
-    auto tag = uidManager->getTag(typeId);
+    auto tag = m_uidManager->getTag(typeId);
     if (tag != UIDManager::NONE_TAG) {
         m_typeId = typeId;
         m_typeTagName = tag;
@@ -37,24 +36,23 @@ DataNode::DataNode(FdfUID typeId)
 
 FdfUID DataNode::typeId() const
 {
-    return m_typeId;
+    // the stored UID may have been overridden, read the canonical type
+    return m_uidManager->resolve(m_typeId);
 }
 
 void DataNode::setTypeId(const FdfUID &typeId)
 {
     // Here, the intention is to use the existing type tag for the given type ID
-    auto uidManager = TabManager::getUIDManager();
     m_typeId = typeId;
-    m_typeTagName = uidManager->getTag(m_typeId);
+    m_typeTagName = m_uidManager->getTag(m_typeId);
     updateDisplayName();
 }
 
 void DataNode::setTypeTagName(const QString &name)
 {
     // Here, the type tag for this port's type ID will be changed
-    auto uidManager = TabManager::getUIDManager();
     m_typeTagName = constants::sanitizeCaption(name);
-    uidManager->updateMap(m_typeId, m_typeTagName);
+    m_uidManager->updateMap(m_typeId, m_typeTagName);
     updateDisplayName();
 }
 
@@ -76,8 +74,7 @@ QString DataNode::annotation() const
 
 void DataNode::updateDisplayName()
 {
-    auto uidManager = TabManager::getUIDManager();
-    m_typeTagName = uidManager->getTag(m_typeId);
+    m_typeTagName = m_uidManager->getTag(m_typeId);
     m_type.name = m_annotation.isEmpty() ? m_typeTagName : m_typeTagName + "_" + m_annotation;
 }
 
@@ -89,9 +86,8 @@ void DataNode::setPlaceHolderCaption(QString typeTag, QString annot)
 
 void DataNode::setParams(const QString &name)
 {
-    auto uidManager = TabManager::getUIDManager();
-    m_typeId = uidManager->createUID(name);
-    m_typeTagName = uidManager->getTag(m_typeId);
+    m_typeId = m_uidManager->createUID(name);
+    m_typeTagName = m_uidManager->getTag(m_typeId);
 }
 
 FunctionNode::FunctionNode()
@@ -107,7 +103,12 @@ FunctionNode::FunctionNode(const QString &name)
 
 Signature FunctionNode::signature() const
 {
-    return m_signature;
+    Signature resolved = m_signature;
+    for (FdfUID &id : resolved.inputs)
+        id = m_uidManager->resolve(id);
+    for (FdfUID &id : resolved.outputs)
+        id = m_uidManager->resolve(id);
+    return resolved;
 }
 
 void FunctionNode::setSignature(const Signature &signature)
@@ -120,6 +121,7 @@ bool FunctionNode::hasValidSignature() const
     if (m_signature.isEmpty())
         return false;
 
+    // overrides never resolve to NONE_ID, the stored UIDs can be checked directly
     auto isNone = [](const auto &id) { return id == UIDManager::NONE_ID; };
 
     if (std::any_of(m_signature.inputs.begin(), m_signature.inputs.end(), isNone))
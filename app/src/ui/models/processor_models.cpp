@@ -153,7 +153,8 @@ bool ExternalProcessorModel::canConnect(ConnectionInfo &connInfo) const
         // may want to disconnect data after this
         return true;
     // note that the first input is the function from a previous block
-    connInfo.expectedInType = m_signature.inputs.at(--index);
+    auto uidManager = TabManager::getUIDManager();
+    connInfo.expectedInType = uidManager->resolve(m_signature.inputs.at(--index));
     if (connInfo.expectedInType != connInfo.receivedOutType) {
         return warnInvalidConnection(connInfo, constants::TYPE_MISMATCH);
     }
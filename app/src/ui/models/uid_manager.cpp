@@ -8,11 +8,8 @@ UIDManager::UIDManager() {}
 
 FdfUID UIDManager::createUID()
 {
-    FdfUID uid = 0;
-    if (!uidToTag.empty()) {
-        // find biggest uid in the map, and increment 1 to create new uid
-        uid = uidToTag.rbegin()->first + 1;
-    }
+    // merged UIDs are still referenced by ports, so they are never handed out again
+    FdfUID uid = ++lastUid;
     QString tag = QString("data_%1").arg(uid);
     updateMap(uid, tag);
     return uid;
@@ -20,11 +17,7 @@ FdfUID UIDManager::createUID()
 
 FdfUID UIDManager::createUID(QString tag)
 {
-    FdfUID uid = 0;
-    if (!uidToTag.empty()) {
-        // find biggest uid in the map, and increment 1 to create new uid
-        uid = uidToTag.rbegin()->first + 1;
-    }
+    FdfUID uid = ++lastUid;
     // make sure the tag is unique
     QString newTag = getUniqueTag(tag);
     updateMap(uid, newTag);
@@ -50,138 +43,196 @@ FdfUID UIDManager::getUid(const QString &tag) const
 
 QString UIDManager::getTag(const FdfUID &uid) const
 {
-    auto elem = uidToTag.find(uid);
+    auto elem = uidToTag.find(resolve(uid));
     if (elem != uidToTag.end())
         return elem->second;
     return NONE_TAG;
 }
 
+FdfUID UIDManager::resolve(FdfUID uid) const
+{
+    FdfUID top = root(uid);
+    auto it = canonical.find(top);
+    return it != canonical.end() ? it->second : top;
+}
+
+FdfUID UIDManager::root(FdfUID uid) const
+{
+    // union by rank keeps the paths logarithmic
+    for (auto it = parent.find(uid); it != parent.end(); it = parent.find(uid))
+        uid = it->second;
+    return uid;
+}
+
+FdfUID UIDManager::find(FdfUID uid)
+{
+    FdfUID top = root(uid);
+    while (uid != top) {
+        FdfUID next = parent.at(uid);
+        if (next != top)
+            write(&UIDManager::parent, uid, top);
+        uid = next;
+    }
+    return top;
+}
+
+void UIDManager::unite(FdfUID removeId, FdfUID keepId)
+{
+    FdfUID removeRoot = find(removeId);
+    FdfUID keepRoot = find(keepId);
+    if (removeRoot == keepRoot)
+        return;
+    auto rankOf = [this](FdfUID id) {
+        auto it = rank.find(id);
+        return it != rank.end() ? it->second : 0;
+    };
+    FdfUID top = keepRoot, child = removeRoot;
+    if (rankOf(top) < rankOf(child))
+        std::swap(top, child);
+    write(&UIDManager::parent, child, top);
+    if (rankOf(top) == rankOf(child))
+        write(&UIDManager::rank, top, rankOf(top) + 1);
+    if (canonical.count(child))
+        write(&UIDManager::canonical, child, std::nullopt);
+    if (top != keepId) // the root is the removed type, the set keeps the other tag
+        write(&UIDManager::canonical, top, keepId);
+}
+
+void UIDManager::write(Table table, FdfUID key, std::optional<int> value)
+{
+    auto &map = this->*table;
+    auto it = map.find(key);
+    std::optional<int> previous;
+    if (it != map.end())
+        previous = it->second;
+    journal.push_back({table, key, previous});
+    if (value)
+        map[key] = *value;
+    else if (it != map.end())
+        map.erase(it);
+}
+
 void UIDManager::updateMap(FdfUID &uid, QString &tag)
 {
     if (uid == NONE_ID || tag == NONE_TAG)
         return;
     tag.replace(" ", "");
-    if (uidToTag.find(uid) == uidToTag.end()) {
+    FdfUID id = resolve(find(uid));
+    if (uidToTag.find(id) == uidToTag.end()) {
         // UID is created afresh, triggered from createUid()
-        uidToTag[uid] = tag;
-        tagToUid[tag] = uid;
+        uidToTag[id] = tag;
+        tagToUid[tag] = id;
     } else {
+        std::vector<NodeId> nodes;
         if (tagToUid.find(tag) == tagToUid.end()) // user changes the type tag on UI for readability
         {
-            tagToUid.erase(getTag(uid)); // remove the current entry from tagToId
+            tagToUid.erase(getTag(id)); // remove the current entry from tagToId
             // Update both maps
-            tagToUid[tag] = uid;
-            uidToTag[uid] = tag;
-        } else if (uidToTag[uid] == tag) {
+            tagToUid[tag] = id;
+            uidToTag[id] = tag;
+            if (graph)
+                nodes = graph->nodesUsingType(id);
+        } else if (uidToTag[id] == tag) {
             // nothing to update, return
             return;
         } else // user chooses to override a type mismatch, setting a type to another existent type
         {
-            FdfUID removeId = std::max(uid, getUid(tag));
-            FdfUID keepId = std::min(uid, getUid(tag));
-            // update the graph to replace all instances of removeId with keepId
-            overrideType(removeId, keepId);
-            tagToUid.erase(getTag(removeId));
+            FdfUID removeId = std::max(id, getUid(tag));
+            FdfUID keepId = std::min(id, getUid(tag));
+            if (graph)
+                nodes = graph->nodesUsingType(removeId);
+            QString removeTag = uidToTag.at(removeId);
+            // ports keep their UID, they resolve to keepId from now on
+            overrides.push_back({removeId, keepId, removeTag, journal.size()});
+            unite(removeId, keepId);
+            tagToUid.erase(removeTag);
             uidToTag.erase(removeId);
         }
-        refreshDisplayNames(); // calls updateDisplayName on all DataNodes on a type override
+        GraphUpdate update(graph);
+        refreshTypes(nodes);
     }
 }
 
-void UIDManager::displayMaps() const
+bool UIDManager::undoLastOverride()
 {
-    qInfo() << "UID to Tag Map:";
-    for (const auto &pair : uidToTag) {
-        qInfo() << "UID:" << pair.first << "-> Tag:" << pair.second;
+    if (overrides.empty())
+        return false;
+    Override last = overrides.back();
+    overrides.pop_back();
+    FdfUID keepId = resolve(last.keepId);
+    std::vector<NodeId> nodes;
+    if (graph)
+        nodes = graph->nodesUsingType(keepId);
+
+    // the union and the compressions since, the tables are back to how the override found them
+    while (journal.size() > last.journalSize) {
+        Change change = journal.back();
+        journal.pop_back();
+        auto &map = this->*change.table;
+        if (change.value)
+            map[change.key] = *change.value;
+        else
+            map.erase(change.key);
     }
+    QString tag = getUniqueTag(last.tag);
+    uidToTag[last.removeId] = tag;
+    tagToUid[tag] = last.removeId;
 
-    qInfo() << "Tag to UID Map:";
-    for (const auto &pair : tagToUid) {
-        qInfo() << "Tag:" << pair.first << "-> UID:" << pair.second;
+    if (graph) {
+        GraphUpdate update(graph);
+        refreshTypes(nodes);
     }
+    return true;
 }
 
-void UIDManager::refreshDisplayNames()
+void UIDManager::refreshTypes(const std::vector<NodeId> &nodes)
 {
     if (!graph) {
         qWarning() << "UID Manager does not have an associated graph!";
         return;
     }
-
-    for (const auto &id : graph->allNodeIds()) {
+    if (graph->isBulkLoading())
+        return; // every port is refreshed once when the load ends
+    std::vector<FdfBlockModel *> updated;
+    for (const auto &id : nodes) {
         auto block = graph->delegateModel<FdfBlockModel>(id);
         if (!block)
             continue;
+        graph->indexNodeTypes(id);
 
+        bool renamed = false;
         for (int i = 0; i < block->nPorts(PortType::Out); i++) {
             if (auto dataPort = std::dynamic_pointer_cast<DataNode>(block->outData(i))) {
                 QString currentDisplayName = dataPort->name();
                 dataPort->updateDisplayName();
-                if (currentDisplayName != dataPort->name()) {
-                    block->propagateUpdate();
-                }
+                renamed |= currentDisplayName != dataPort->name();
                 // we need to also ensure output port captions remain unique after tag changes
                 // since captions are now deterministic
                 graph->makeOutPortsUnique(id, block, i);
             }
         }
+        // signatures resolve on read, so function ports are always refreshed downstream
+        if (renamed || block->hasFunctionOutPorts())
+            updated.push_back(block);
     }
+    // single refresh for every block touched by the edit
+    for (auto block : updated)
+        block->propagateUpdate();
 }
 
-void UIDManager::overrideType(FdfUID removeType, FdfUID keepType)
+void UIDManager::displayMaps() const
 {
-    if (!graph) {
-        qWarning() << "UID Manager does not have an associated graph!";
-        return;
+    qInfo() << "UID to Tag Map:";
+    for (const auto &pair : uidToTag) {
+        qInfo() << "UID:" << pair.first << "-> Tag:" << pair.second;
     }
-    // Update types in the graph
-    for (const auto &id : graph->allNodeIds()) {
-        auto block = graph->delegateModel<FdfBlockModel>(id);
-        if (!block)
-            continue;
 
-        bool updated = false;
-
-        for (int i = 0; i < block->nPorts(PortType::Out); i++) {
-            auto dataPort = std::dynamic_pointer_cast<DataNode>(block->outData(i));
-            if (dataPort && dataPort->typeId() == removeType) {
-                dataPort->setTypeId(keepType);
-                updated = true;
-                continue;
-            }
-
-            auto functionPort = std::dynamic_pointer_cast<FunctionNode>(block->outData(i));
-            if (!functionPort)
-                continue;
-
-            Signature signature = functionPort->signature();
-
-            // Replace type in input and output signatures
-            updated |= replaceTypesInUIDVector(signature.inputs, keepType, removeType);
-            updated |= replaceTypesInUIDVector(signature.outputs, keepType, removeType);
-
-            if (updated)
-                functionPort->setSignature(signature);
-        }
-
-        if (updated)
-            block->propagateUpdate();
+    qInfo() << "Tag to UID Map:";
+    for (const auto &pair : tagToUid) {
+        qInfo() << "Tag:" << pair.first << "-> UID:" << pair.second;
     }
 }
 
-bool UIDManager::replaceTypesInUIDVector(std::vector<FdfUID> &vec,
-                                         FdfUID keepType,
-                                         FdfUID removeType)
-{
-    bool updated = false;
-    for (FdfUID &item : vec)
-        if (item == removeType) {
-            item = keepType;
-            updated = true;
-        }
-    return updated;
-}
-
 ConnectionInfo UIDManager::getConnectionInfo(QtNodes::ConnectionId const connectionId) const
 {
     ConnectionInfo connInfo;
@@ -222,7 +273,8 @@ FdfUID UIDManager::getOrCreateUIDOnFuncLoad(const QString &fileHash, int origina
     auto &mapForFile = fileUidCache[fileHash];
     auto it = mapForFile.find(originalId);
     if (it != mapForFile.end()) {
-        return it->second;
+        // the cached UID may have been overridden since, resolve instead of rewriting the cache
+        return resolve(it->second);
     }
 
     FdfUID newId = createUID();
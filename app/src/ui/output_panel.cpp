@@ -1,9 +1,24 @@
 #include "ui/output_panel.hpp"
 
-#include <QApplication>
+#include <QRegularExpression>
 
 OutputPanel::OutputPanel(QWidget *parent)
-    : QPlainTextEdit(parent)
+    : LogView(parent)
+{}
+
+void OutputPanel::appendText(const QString &text)
 {
-    setReadOnly(true);
-}
\ No newline at end of file
+    static const QRegularExpression ERROR_LINE("\\b(ERROR|CRITICAL|Traceback)\\b");
+    static const QRegularExpression WARNING_LINE("\\bWARNING\\b");
+    std::vector<LogModel::Line> lines;
+    QString trimmed = text.endsWith('\n') ? text.chopped(1) : text;
+    for (const auto &line : trimmed.split('\n')) {
+        QtMsgType type = QtInfoMsg;
+        if (line.contains(ERROR_LINE))
+            type = QtCriticalMsg;
+        else if (line.contains(WARNING_LINE))
+            type = QtWarningMsg;
+        lines.push_back({line, type});
+    }
+    appendLines(lines);
+}
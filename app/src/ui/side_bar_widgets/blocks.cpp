@@ -28,6 +28,7 @@
 
 #include "data/block_manager.hpp"
 #include "data/constants.hpp"
+#include "data/custom_graph.hpp"
 #include "data/tab_manager.hpp"
 #include "ui/models/composer_models.hpp"
 #include "ui/models/fdf_block_model.hpp"
@@ -44,7 +45,10 @@ constexpr uint OUTPUT_PORT_ROW = 4;
 constexpr uint TRAINER_INPUT_ROW = 5;
 constexpr uint TRAINER_OUTPUT_ROW = 6;
 constexpr uint PARAMETER_ROW = 7;
+constexpr uint PARAMETER_EDITOR_ROW = 8;
 constexpr uint PORT_TYPE_MAP_ROW = 9;
+constexpr uint PORT_TABLE_ROW = 10;
+constexpr int PARAMETER_EDIT_DELAY_MSECS = 300;
 } // namespace
 
 Blocks::Blocks(std::shared_ptr<BlockManager> blockManager,
@@ -64,6 +68,9 @@ Blocks::Blocks(std::shared_ptr<BlockManager> blockManager,
     , m_trainerInputEdit(new QSpinBox)
     , m_trainerOutputEdit(new QSpinBox)
     , m_parametersWidget(new QStackedWidget)
+    , m_portsTable(nullptr)
+    , m_parameterTimer(new QTimer(this))
+    , m_pendingNodeId(QtNodes::InvalidNodeId)
     , m_library(new QCollapsibleWidget("Library"))
     , m_globals(new QCollapsibleWidget("Globals"))
     , m_randomStateSpinBox(new QSpinBox)
@@ -71,12 +78,21 @@ Blocks::Blocks(std::shared_ptr<BlockManager> blockManager,
     initUi();
 
     connect(m_blockManager.get(), &BlockManager::nodeSelected, this, &Blocks::setNodeId);
+    // edits still waiting belong to the graph of the previous tab
+    connect(m_tabManager.get(), &TabManager::currentChanged, this, &Blocks::flushParameters);
+}
+
+Blocks::~Blocks()
+{
+    flushParameters();
 }
 
 void Blocks::setNodeId(QtNodes::NodeId id)
 {
     if (m_nodeId == id)
         return;
+    // edits still waiting belong to the previous block
+    flushParameters();
     m_nodeId = id;
     emit nodeIdChanged(id);
 }
@@ -87,14 +103,6 @@ void Blocks::updateFields()
     auto block = m_blockManager->getBlock(m_nodeId);
     enableEditorWidgets(block);
     handleInputRows(block);
-    if (auto widget = m_parametersWidget->currentWidget()) {
-        m_parametersWidget->removeWidget(widget);
-        widget->deleteLater();
-    }
-    if (auto widget = m_outputPorts->currentWidget()) {
-        m_outputPorts->removeWidget(widget);
-        widget->deleteLater();
-    }
     if (!block) {
         m_idEdit->clear();
         m_captionEdit->clear();
@@ -106,7 +114,9 @@ void Blocks::updateFields()
         m_idEdit->setText(QString::number(m_nodeId));
         m_functionNameEdit->setText(block->functionName());
         QString sanitizedCaption = constants::sanitizeCaption(block->caption());
-        m_captionEdit->setText(sanitizedCaption);
+        // setText moves the cursor, leave the edit alone while it already shows the caption
+        if (m_captionEdit->text() != sanitizedCaption)
+            m_captionEdit->setText(sanitizedCaption);
         m_inputPortEdit->setMinimum(
             block->minModifiablePorts(PortType::In, constants::DATA_PORT_ID));
         if (auto composer = dynamic_cast<ComposerModel *>(block))
@@ -121,15 +131,10 @@ void Blocks::updateFields()
         else
             m_outputPortEdit->setValue(block->nPorts(PortType::Out, constants::DATA_PORT_ID));
         m_outputPortEdit->setEnabled(block->portNumberModifiable(PortType::Out));
-
-        if (auto parameterWidget = generateParameterWidget(block))
-            m_parametersWidget->addWidget(parameterWidget);
-        if (auto outputWidget = generatePortsWidget(block))
-            m_outputPorts->addWidget(outputWidget);
     }
+    updateParameterWidget(block);
+    updatePortsWidget(block);
     m_editorLayout->setRowVisible(FUNCTION_ROW, block && !block->functionName().isEmpty());
-    m_editorLayout->setRowVisible(PARAMETER_ROW, m_parametersWidget->currentWidget());
-    m_editorLayout->setRowVisible(PORT_TYPE_MAP_ROW, m_outputPorts->currentWidget());
 
     blockEditorSignals(false);
 }
@@ -281,10 +286,8 @@ void Blocks::initEditor()
     m_editorLayout->setRowVisible(TRAINER_OUTPUT_ROW, false);
 
     m_editorLayout->addRow(new QLabel("Parameters"));
-    m_editorLayout->setRowVisible(PARAMETER_ROW, false);
     m_editorLayout->addRow(m_parametersWidget);
     m_editorLayout->addRow(new QLabel("Ports-Type Map:"));
-    m_editorLayout->setRowVisible(PORT_TYPE_MAP_ROW, false);
     m_editorLayout->addRow(m_outputPorts);
     m_blockEditor->setWidget(formWidget);
 
@@ -299,6 +302,10 @@ void Blocks::initEditor()
     // these will be enabled/disabled after updateFields();
     m_editableEditorWidgets = {m_captionEdit, m_inputPortEdit, m_outputPortEdit};
 
+    m_parameterTimer->setSingleShot(true);
+    m_parameterTimer->setInterval(PARAMETER_EDIT_DELAY_MSECS);
+    connect(m_parameterTimer, &QTimer::timeout, this, &Blocks::flushParameters);
+
     // init initial disabled state
     updateFields();
 
@@ -307,10 +314,13 @@ void Blocks::initEditor()
 
     setupCaptionValidation();
 
+    // port count changes reconnect ports, downstream blocks are propagated once on commit
     connect(m_inputPortEdit, &QSpinBox::valueChanged, this, [this](int value) {
+        GraphUpdate update(m_tabManager->currentGraph());
         m_blockManager->getBlock(m_nodeId)->setInputPortNumber(value);
     });
     connect(m_outputPortEdit, &QSpinBox::valueChanged, this, [this](int value) {
+        GraphUpdate update(m_tabManager->currentGraph());
         m_blockManager->getBlock(m_nodeId)->setOutputPortNumber(value);
     });
     connect(m_trainerInputEdit, &QSpinBox::valueChanged, this, [this](int value) {
@@ -420,19 +430,16 @@ void Blocks::enableEditorWidgets(bool value)
         widget->setEnabled(value);
 }
 
-QWidget *Blocks::generatePortsWidget(FdfBlockModel *block)
+void Blocks::updatePortsWidget(FdfBlockModel *block)
 {
-    if (!block)
-        return nullptr;
-
-    int portCount = block->nPorts(PortType::Out);
-    if (portCount == 0)
-        return nullptr;
-
+    int portCount = block ? block->nPorts(PortType::Out) : 0;
     auto uidManager = m_tabManager->getCurrentUIDManager();
-    if (!uidManager) {
+    if (portCount > 0 && !uidManager)
         qWarning() << "UIDManager is null!";
-        return nullptr;
+    if (portCount == 0 || !uidManager) {
+        m_editorLayout->setRowVisible(PORT_TYPE_MAP_ROW, false);
+        m_editorLayout->setRowVisible(PORT_TABLE_ROW, false);
+        return;
     }
 
     bool hasDataPort = block->hasDataOutPorts();
@@ -460,87 +467,104 @@ QWidget *Blocks::generatePortsWidget(FdfBlockModel *block)
         headers << "Caption";
     }
 
-    auto tableWidget = new QTableWidget(portCount,
-                                        visibleCols.size()); // Number of columns of side table
-    tableWidget->setHorizontalHeaderLabels(headers);
-    tableWidget->verticalHeader()->setVisible(false);
-    tableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    tableWidget->setSelectionMode(QAbstractItemView::NoSelection);
-    tableWidget->resizeRowsToContents();
-    tableWidget->resizeColumnsToContents();
-
-    for (int i = 0; i < portCount; ++i) {
-        int colIndex = 0;
-        auto outData = block->outData(i);
-        auto dataNode = std::dynamic_pointer_cast<DataNode>(outData);
-        auto funcNode = std::dynamic_pointer_cast<FunctionNode>(outData);
-
-        for (int col : visibleCols) {
-            QTableWidgetItem *item = nullptr;
-
-            switch (col) {
-            case constants::PortTableColIndex::COL_PORT_ID:
-                item = new QTableWidgetItem(QString::number(i));
-                item->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-                break;
-
-            case constants::PortTableColIndex::COL_TYPE_TAG:
-                if (dataNode) {
-                    QString tag = uidManager->getTag(dataNode->typeId());
-                    item = new QTableWidgetItem(tag);
-
-                    // Disable editing if the type ID is NONE_ID
-                    if (dataNode->typeId() == UIDManager::NONE_ID) {
-                        item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-                        item->setBackground(QColor("#e0e0e0"));
-                        item->setToolTip("NONE_ID type cannot be edited");
-                    } else
-                        item->setFlags(Qt::ItemIsEditable | Qt::ItemIsSelectable
-                                       | Qt::ItemIsEnabled);
-                } else {
-                    item = new QTableWidgetItem("");
-                    item->setBackground(QColor("#e0e0e0"));
-                    item->setFlags(Qt::NoItemFlags);
-                }
-                break;
-
-            case constants::PortTableColIndex::COL_ANNOTATION:
-                if (dataNode) {
-                    item = new QTableWidgetItem(dataNode->annotation());
-                    item->setFlags(Qt::ItemIsEditable | Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-                } else {
-                    item = new QTableWidgetItem("");
-                    item->setBackground(QColor("#e0e0e0"));
-                    item->setFlags(Qt::NoItemFlags);
-                }
-                break;
-
-            case constants::PortTableColIndex::COL_CAPTION:
-                if (funcNode) {
-                    item = new QTableWidgetItem(funcNode->name());
-                    item->setFlags(Qt::ItemIsEditable | Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-                } else {
-                    item = new QTableWidgetItem("");
-                    item->setBackground(QColor("#e0e0e0"));
-                    item->setFlags(Qt::NoItemFlags);
+    // the table is only rebuilt when its columns change, otherwise the cells are patched
+    if (!m_portsTable || m_portColumns != visibleCols) {
+        if (m_portsTable) {
+            m_outputPorts->removeWidget(m_portsTable);
+            m_portsTable->deleteLater();
+        }
+        m_portColumns = visibleCols;
+        m_portsTable = new QTableWidget(0, visibleCols.size()); // Number of columns of side table
+        m_portsTable->setHorizontalHeaderLabels(headers);
+        m_portsTable->verticalHeader()->setVisible(false);
+        m_portsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        m_portsTable->setSelectionMode(QAbstractItemView::NoSelection);
+        m_outputPorts->addWidget(m_portsTable);
+        connect(m_portsTable, &QTableWidget::itemChanged, this, [this](QTableWidgetItem *item) {
+            handlePortEdit(m_blockManager->getBlock(m_nodeId),
+                           m_portsTable,
+                           item,
+                           m_tabManager->getCurrentUIDManager(),
+                           m_portColumns);
+        });
+    }
+
+    {
+        QSignalBlocker blocker(m_portsTable);
+        m_portsTable->setRowCount(portCount);
+        for (int i = 0; i < portCount; ++i) {
+            for (int colIndex = 0; colIndex < visibleCols.size(); ++colIndex) {
+                auto item = m_portsTable->item(i, colIndex);
+                if (!item) {
+                    item = new QTableWidgetItem;
+                    m_portsTable->setItem(i, colIndex, item);
                 }
-                break;
+                fillPortItem(item, block, i, visibleCols.at(colIndex), uidManager);
             }
-
-            if (item)
-                tableWidget->setItem(i, colIndex, item);
-
-            ++colIndex;
         }
     }
+    m_outputPorts->setCurrentWidget(m_portsTable);
+    m_editorLayout->setRowVisible(PORT_TYPE_MAP_ROW, true);
+    m_editorLayout->setRowVisible(PORT_TABLE_ROW, true);
+}
 
-    connect(tableWidget,
-            &QTableWidget::itemChanged,
-            block,
-            [block, tableWidget, uidManager, visibleCols, this](QTableWidgetItem *item) {
-                handlePortEdit(block, tableWidget, item, uidManager, visibleCols);
-            });
-    return tableWidget;
+void Blocks::fillPortItem(
+    QTableWidgetItem *item, FdfBlockModel *block, int row, int col, UIDManager *uidManager)
+{
+    const QColor disabledColor("#e0e0e0");
+    const Qt::ItemFlags editableFlags = Qt::ItemIsEditable | Qt::ItemIsSelectable
+                                        | Qt::ItemIsEnabled;
+    auto outData = block->outData(row);
+    auto dataNode = std::dynamic_pointer_cast<DataNode>(outData);
+    auto funcNode = std::dynamic_pointer_cast<FunctionNode>(outData);
+
+    // setData ignores unchanged values, so only the cells that differ are repainted
+    QString text;
+    Qt::ItemFlags flags = Qt::NoItemFlags;
+    QVariant background;
+    QString toolTip;
+    switch (col) {
+    case constants::PortTableColIndex::COL_PORT_ID:
+        text = QString::number(row);
+        flags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+        break;
+
+    case constants::PortTableColIndex::COL_TYPE_TAG:
+        if (dataNode) {
+            text = uidManager->getTag(dataNode->typeId());
+            // Disable editing if the type ID is NONE_ID
+            if (dataNode->typeId() == UIDManager::NONE_ID) {
+                flags = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+                background = QBrush(disabledColor);
+                toolTip = "NONE_ID type cannot be edited";
+            } else
+                flags = editableFlags;
+        } else
+            background = QBrush(disabledColor);
+        break;
+
+    case constants::PortTableColIndex::COL_ANNOTATION:
+        if (dataNode) {
+            text = dataNode->annotation();
+            flags = editableFlags;
+        } else
+            background = QBrush(disabledColor);
+        break;
+
+    case constants::PortTableColIndex::COL_CAPTION:
+        if (funcNode) {
+            text = funcNode->name();
+            flags = editableFlags;
+        } else
+            background = QBrush(disabledColor);
+        break;
+    }
+    item->setText(text);
+    item->setData(Qt::BackgroundRole, background);
+    item->setToolTip(toolTip);
+    // setFlags always notifies the view
+    if (item->flags() != flags)
+        item->setFlags(flags);
 }
 
 void Blocks::handlePortEdit(FdfBlockModel *block,
@@ -591,49 +615,100 @@ void Blocks::handlePortEdit(FdfBlockModel *block,
     }
 }
 
-QWidget *Blocks::generateParameterWidget(FdfBlockModel *block)
+void Blocks::updateParameterWidget(FdfBlockModel *block)
 {
-    if (!block)
-        return nullptr;
+    auto values = block ? block->getParameters() : std::unordered_map<QString, QString>();
+    if (values.empty()) {
+        m_editorLayout->setRowVisible(PARAMETER_ROW, false);
+        m_editorLayout->setRowVisible(PARAMETER_EDITOR_ROW, false);
+        return;
+    }
+    // rows are only created for the keys that have a value
+    QStringList keys;
+    for (auto &pair : block->getParameterSchema())
+        if (values.count(pair.first) > 0)
+            keys << pair.first;
+    keys.sort();
+    QString signature = block->name() + '|' + keys.join(',');
+    auto it = m_parameterEditors.find(signature);
+    if (it == m_parameterEditors.end()) {
+        it = m_parameterEditors.emplace(signature, createParameterEditor(block)).first;
+        m_parametersWidget->addWidget(it->second.widget);
+    }
+
+    // an edit that is not applied yet is newer than the block
+    bool editing = m_pendingGraph == m_tabManager->currentGraph() && m_pendingNodeId == m_nodeId;
+    for (auto &[key, field] : it->second.fields) {
+        if (editing && m_pendingParameters.count(key) > 0)
+            continue;
+        auto value = values.at(key);
+        if (!field.shows(value))
+            field.setValue(value);
+    }
+    m_parametersWidget->setCurrentWidget(it->second.widget);
+    m_editorLayout->setRowVisible(PARAMETER_ROW, true);
+    m_editorLayout->setRowVisible(PARAMETER_EDITOR_ROW, true);
+}
+
+Blocks::ParameterEditor Blocks::createParameterEditor(FdfBlockModel *block)
+{
+    // rows edit the selected block, so one editor serves every block of the type
+    ParameterEditor editor;
     auto values = block->getParameters();
-    if (values.empty())
-        return nullptr;
-    auto widget = new QWidget;
-    auto layout = new QFormLayout(widget);
+    editor.widget = new QWidget;
+    auto layout = new QFormLayout(editor.widget);
     layout->setContentsMargins(0, 0, 0, 0);
     for (auto &pair : block->getParameterSchema()) {
         auto key = pair.first;
         // value is not found for now, we need to decide how to add optional params
         if (values.count(key) < 1)
             continue;
-        auto value = values.at(key);
         if (pair.second == QMetaType::QString) {
             auto options = block->getParameterOptions(key);
             if (options.isEmpty()) {
-                auto edit = new QLineEdit(value);
+                auto edit = new QLineEdit;
                 layout->addRow(new QLabel(key), edit);
-                connect(edit, &QLineEdit::textChanged, block, [block, key](const QString &text) {
-                    block->setParameter(key, text);
+                editor.fields[key] = {[edit](const QString &value) {
+                                          return edit->text() == value;
+                                      },
+                                      [edit](const QString &value) {
+                                          QSignalBlocker blocker(edit);
+                                          edit->setText(value);
+                                      }};
+                connect(edit, &QLineEdit::textChanged, this, [this, key](const QString &text) {
+                    queueParameter(key, text);
                 });
             } else {
                 auto comboBox = new QComboBox;
                 comboBox->addItems(options);
-                comboBox->setCurrentText(value);
                 layout->addRow(new QLabel(key), comboBox);
+                editor.fields[key] = {[comboBox](const QString &value) {
+                                          return comboBox->currentText() == value;
+                                      },
+                                      [comboBox](const QString &value) {
+                                          QSignalBlocker blocker(comboBox);
+                                          comboBox->setCurrentText(value);
+                                      }};
                 connect(comboBox,
                         &QComboBox::currentTextChanged,
-                        block,
-                        [block, key](const QString &text) { block->setParameter(key, text); });
+                        this,
+                        [this, key](const QString &text) { queueParameter(key, text); });
             }
         } else if (pair.second == QMetaType::Int) {
             auto spin = new QSpinBox;
             spin->setRange(std::numeric_limits<int>::lowest(), std::numeric_limits<int>::max());
             spin->setMaximumWidth(constants::INT_SPIN_BOX_MAX_WIDTH);
             spin->setMinimumWidth(constants::INT_SPIN_BOX_MIN_WIDTH);
-            spin->setValue(value.toInt());
             layout->addRow(new QLabel(key), spin);
-            connect(spin, &QSpinBox::valueChanged, block, [block, key](const int &value) {
-                block->setParameter(key, QString::number(value));
+            editor.fields[key] = {[spin](const QString &value) {
+                                      return spin->value() == value.toInt();
+                                  },
+                                  [spin](const QString &value) {
+                                      QSignalBlocker blocker(spin);
+                                      spin->setValue(value.toInt());
+                                  }};
+            connect(spin, &QSpinBox::valueChanged, this, [this, key](const int &value) {
+                queueParameter(key, QString::number(value));
             });
         } else if (pair.second == QMetaType::Double) {
             auto spin = new QDoubleSpinBox;
@@ -641,56 +716,98 @@ QWidget *Blocks::generateParameterWidget(FdfBlockModel *block)
             spin->setDecimals(4);
             spin->setMaximumWidth(constants::DOUBLE_SPIN_BOX_MAX_WIDTH);
             spin->setMinimumWidth(constants::DOUBLE_SPIN_BOX_MIN_WIDTH);
-            spin->setValue(value.toDouble());
             layout->addRow(new QLabel(key), spin);
-            connect(spin, &QDoubleSpinBox::valueChanged, block, [block, key](double value) {
-                block->setParameter(key, QString::number(value, 'f', 6));
+            // compared as numbers, the block stores them in another format than the spin box
+            editor.fields[key] = {[spin](const QString &value) {
+                                      return qFuzzyCompare(spin->value(), value.toDouble());
+                                  },
+                                  [spin](const QString &value) {
+                                      QSignalBlocker blocker(spin);
+                                      spin->setValue(value.toDouble());
+                                  }};
+            connect(spin, &QDoubleSpinBox::valueChanged, this, [this, key](double value) {
+                queueParameter(key, QString::number(value, 'f', 6));
             });
         } else if (pair.second == QMetaType::QPoint) {
             auto pointLayout = new QHBoxLayout();
-            {
-                int xValue = value.mid(value.indexOf('[') + 1, value.indexOf(',') - 1).toInt();
-                int yValue = value.mid(value.indexOf(' ') + 1, value.indexOf(']') - 1).toInt();
-                pointLayout->setContentsMargins(0, 0, 0, 0);
-                pointLayout->setSpacing(0);
-                auto xSpin = new QSpinBox;
-                xSpin->setRange(0, std::numeric_limits<int>::max());
-                xSpin->setMaximumWidth(constants::INT_SPIN_BOX_MAX_WIDTH);
-                xSpin->setMinimumWidth(constants::INT_SPIN_BOX_MIN_WIDTH);
-                xSpin->setValue(xValue);
-                pointLayout->addWidget(xSpin);
-                pointLayout->addWidget(new QLabel(", "));
-                auto ySpin = new QSpinBox;
-                ySpin->setRange(0, std::numeric_limits<int>::max());
-                ySpin->setMaximumWidth(constants::INT_SPIN_BOX_MAX_WIDTH);
-                ySpin->setMinimumWidth(constants::INT_SPIN_BOX_MIN_WIDTH);
-                ySpin->setValue(yValue);
-                pointLayout->addWidget(ySpin);
-                connect(xSpin, &QSpinBox::valueChanged, block, [block, key, ySpin](const int &value) {
-                    block->setParameter(key,
-                                        QString("[%1, %2]")
-                                            .arg(QString::number(value),
-                                                 QString::number(ySpin->value())));
-                });
-                connect(ySpin, &QSpinBox::valueChanged, block, [block, key, xSpin](const int &value) {
-                    block->setParameter(key,
-                                        QString("[%1, %2]")
-                                            .arg(QString::number(xSpin->value()), value));
-                });
-            }
+            pointLayout->setContentsMargins(0, 0, 0, 0);
+            pointLayout->setSpacing(0);
+            auto xSpin = new QSpinBox;
+            xSpin->setRange(0, std::numeric_limits<int>::max());
+            xSpin->setMaximumWidth(constants::INT_SPIN_BOX_MAX_WIDTH);
+            xSpin->setMinimumWidth(constants::INT_SPIN_BOX_MIN_WIDTH);
+            pointLayout->addWidget(xSpin);
+            pointLayout->addWidget(new QLabel(", "));
+            auto ySpin = new QSpinBox;
+            ySpin->setRange(0, std::numeric_limits<int>::max());
+            ySpin->setMaximumWidth(constants::INT_SPIN_BOX_MAX_WIDTH);
+            ySpin->setMinimumWidth(constants::INT_SPIN_BOX_MIN_WIDTH);
+            pointLayout->addWidget(ySpin);
+            auto pointText = [xSpin, ySpin]() {
+                return QString("[%1, %2]").arg(QString::number(xSpin->value()),
+                                               QString::number(ySpin->value()));
+            };
+            auto showsPoint = [pointText](const QString &value) { return pointText() == value; };
+            editor.fields[key] = {showsPoint, [xSpin, ySpin](const QString &value) {
+                                      QSignalBlocker xBlocker(xSpin);
+                                      QSignalBlocker yBlocker(ySpin);
+                                      xSpin->setValue(
+                                          value.mid(value.indexOf('[') + 1, value.indexOf(',') - 1)
+                                              .toInt());
+                                      ySpin->setValue(
+                                          value.mid(value.indexOf(' ') + 1, value.indexOf(']') - 1)
+                                              .toInt());
+                                  }};
+            connect(xSpin, &QSpinBox::valueChanged, this, [this, key, pointText](int) {
+                queueParameter(key, pointText());
+            });
+            connect(ySpin, &QSpinBox::valueChanged, this, [this, key, pointText](int) {
+                queueParameter(key, pointText());
+            });
             layout->addRow(new QLabel(key), pointLayout);
         } else if (pair.second == QMetaType::QVector2D || pair.second == QMetaType::QVariantList) {
             // UI for this can be improved
-            auto edit = new QLineEdit(value);
+            auto edit = new QLineEdit;
             layout->addRow(new QLabel(key), edit);
-            connect(edit, &QLineEdit::textChanged, block, [block, key](const QString &text) {
-                block->setParameter(key, text);
+            editor.fields[key] = {[edit](const QString &value) { return edit->text() == value; },
+                                  [edit](const QString &value) {
+                                      QSignalBlocker blocker(edit);
+                                      edit->setText(value);
+                                  }};
+            connect(edit, &QLineEdit::textChanged, this, [this, key](const QString &text) {
+                queueParameter(key, text);
             });
         } else {
             qCritical() << "Block parameter type is unhandled" << pair.second;
         }
     }
-    return widget;
+    return editor;
+}
+
+void Blocks::queueParameter(const QString &key, const QString &value)
+{
+    auto graph = m_tabManager->currentGraph();
+    if (m_pendingGraph != graph || m_pendingNodeId != m_nodeId)
+        flushParameters();
+    m_pendingGraph = graph;
+    m_pendingNodeId = m_nodeId;
+    m_pendingParameters[key] = value;
+    m_parameterTimer->start();
+}
+
+void Blocks::flushParameters()
+{
+    m_parameterTimer->stop();
+    auto parameters = std::move(m_pendingParameters);
+    m_pendingParameters.clear();
+    if (parameters.empty() || !m_pendingGraph || !m_pendingGraph->nodeExists(m_pendingNodeId))
+        return;
+    auto block = m_pendingGraph->delegateModel<FdfBlockModel>(m_pendingNodeId);
+    if (!block)
+        return;
+    // parameters only change the generated code, nothing downstream is propagated
+    for (const auto &[key, value] : parameters)
+        block->updateParameter(key, value);
 }
 
 void Blocks::handleInputRows(FdfBlockModel *block)
@@ -45,13 +45,13 @@ void Charts::updateFields()
 {
     clearFields();
     auto block = m_blockManager->getBlock(m_nodeId);
+    // images, decoded in the background and only when the files changed
+    m_imageGallery->setImages(block ? block->getExecutedGraphs() : QStringList());
     if (!block)
         return;
 
-    //images
-    for (auto &path : block->getExecutedGraphs())
-        m_imageGallery->add(path);
-
+    if (block->isExecutedPreview())
+        m_fieldsLayout->addRow(new QLabel("Preview results, computed on sampled data"));
     //fields
     for (auto &pair : block->getExecutedValues()) {
         auto value = new QLineEdit(pair.second);
@@ -62,9 +62,6 @@ void Charts::updateFields()
 
 void Charts::clearFields()
 {
-    // images
-    m_imageGallery->clear();
-
     //fields
     for (int i = m_fieldsLayout->rowCount() - 1; i >= 0; --i)
         m_fieldsLayout->removeRow(i);
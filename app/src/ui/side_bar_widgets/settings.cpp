@@ -24,6 +24,10 @@ Settings::Settings(MainWindow *mw, QWidget *parent)
     , m_formatBox(new QComboBox)
     , m_engineBox(new QComboBox)
     , m_engineTimeoutBox(new QSpinBox)
+    , m_runCacheBox(new QCheckBox("Reuse results of identical runs"))
+    , m_fusionBox(new QCheckBox("Run linear block chains as one node"))
+    , m_previewRowsBox(new QSpinBox)
+    , m_previewIterationsBox(new QSpinBox)
     , mainWindowPtr(mw)
 {
     auto scrollArea = new QScrollArea;
@@ -52,6 +56,17 @@ Settings::Settings(MainWindow *mw, QWidget *parent)
         m_engineTimeoutBox->setRange(1, 20);
         layout->addWidget(m_engineTimeoutBox);
 
+        layout->addWidget(m_runCacheBox);
+        layout->addWidget(m_fusionBox);
+
+        layout->addWidget(new QLabel("Preview rows per data source: "));
+        m_previewRowsBox->setRange(10, 1000000);
+        layout->addWidget(m_previewRowsBox);
+
+        layout->addWidget(new QLabel("Preview max iterations: "));
+        m_previewIterationsBox->setRange(1, 10000);
+        layout->addWidget(m_previewIterationsBox);
+
         QCheckBox *gridEnable = new QCheckBox("Show Grid", this);
         gridEnable->setChecked(true);
         layout->addWidget(gridEnable);
@@ -61,6 +76,10 @@ Settings::Settings(MainWindow *mw, QWidget *parent)
             m_formatBox->setCurrentText(settingValue("default export format").toString());
             m_engineBox->setCurrentText(settingValue("engine").toString());
             m_engineTimeoutBox->setValue(settingValue("engine timeout (minutes)").toInt());
+            m_runCacheBox->setChecked(settingValue("reuse cached runs").toBool());
+            m_fusionBox->setChecked(settingValue("fuse block chains").toBool());
+            m_previewRowsBox->setValue(settingValue("preview rows").toInt());
+            m_previewIterationsBox->setValue(settingValue("preview max iterations").toInt());
         }
 
         auto &s = data::Settings::instance();
@@ -74,6 +93,18 @@ Settings::Settings(MainWindow *mw, QWidget *parent)
             connect(m_engineTimeoutBox, &QSpinBox::valueChanged, &s, [&s](const int &value) {
                 s.setValue("engine timeout (minutes)", value);
             });
+            connect(m_runCacheBox, &QCheckBox::toggled, &s, [&s](bool checked) {
+                s.setValue("reuse cached runs", checked);
+            });
+            connect(m_fusionBox, &QCheckBox::toggled, &s, [&s](bool checked) {
+                s.setValue("fuse block chains", checked);
+            });
+            connect(m_previewRowsBox, &QSpinBox::valueChanged, &s, [&s](const int &value) {
+                s.setValue("preview rows", value);
+            });
+            connect(m_previewIterationsBox, &QSpinBox::valueChanged, &s, [&s](const int &value) {
+                s.setValue("preview max iterations", value);
+            });
         }
 
         // connects for updating setting changes
@@ -97,6 +128,22 @@ void Settings::onSettingUpdated(const QString &key, const QVariant &value)
         m_engineTimeoutBox->blockSignals(true);
         m_engineTimeoutBox->setValue(value.toInt());
         m_engineTimeoutBox->blockSignals(false);
+    } else if (key == "reuse cached runs") {
+        m_runCacheBox->blockSignals(true);
+        m_runCacheBox->setChecked(value.toBool());
+        m_runCacheBox->blockSignals(false);
+    } else if (key == "fuse block chains") {
+        m_fusionBox->blockSignals(true);
+        m_fusionBox->setChecked(value.toBool());
+        m_fusionBox->blockSignals(false);
+    } else if (key == "preview rows") {
+        m_previewRowsBox->blockSignals(true);
+        m_previewRowsBox->setValue(value.toInt());
+        m_previewRowsBox->blockSignals(false);
+    } else if (key == "preview max iterations") {
+        m_previewIterationsBox->blockSignals(true);
+        m_previewIterationsBox->setValue(value.toInt());
+        m_previewIterationsBox->blockSignals(false);
     } else {
         qCritical() << "Setting update key not handled: " << key;
     }
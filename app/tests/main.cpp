@@ -4,6 +4,9 @@
 int main(int argc, char **argv)
 {
     QApplication app(argc, argv);
+    // keeps the settings the tests write apart from those of the builder
+    QApplication::setOrganizationName("CNRS@CREATE");
+    QApplication::setApplicationName("DesCartes Builder Tests");
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
\ No newline at end of file
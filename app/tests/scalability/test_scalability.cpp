@@ -0,0 +1,181 @@
+#include "data/custom_graph.hpp"
+#include "data/tab_components.hpp"
+#include "data/tab_manager.hpp"
+#include "engine/abstract_engine.hpp"
+#include "engine/kedro.hpp"
+#include "ui/models/fdf_block_model.hpp"
+#include "ui/models/function_names.hpp"
+#include "synthetic_graph.hpp"
+#include <gtest/gtest.h>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <utility>
+
+namespace {
+
+// Budgets per 1000 blocks, generous enough for debug builds on shared runners. Built with
+// BUILD_SCALABILITY_TESTS, ctest runs each size in its own process with the label scalability.
+constexpr double BUILD_MSECS = 4000;
+constexpr double VALIDATE_MSECS = 500;
+constexpr double CODEGEN_MSECS = 500;
+constexpr double SAVE_MSECS = 3000;
+constexpr double OPEN_MSECS = 5000;
+constexpr double EDIT_MSECS = 1000;
+constexpr double MEMORY_MB = 150;
+
+// Generates the kedro files without running kedro, so no python is needed
+class CodegenEngine : public AbstractEngine
+{
+public:
+    bool execute(std::shared_ptr<TabComponents> tab, const RunOptions &) override
+    {
+        auto snapshot = tab->getGraph()->snapshot();
+        m_files = {Kedro::serializeParameters(*snapshot),
+                   Kedro::serializeCatalog(*snapshot),
+                   Kedro::serializePipeline(*snapshot)};
+        emit finished(true);
+        return true;
+    }
+    bool validityCheck(std::shared_ptr<TabComponents> tab) override
+    {
+        auto problems = tab->getGraph()->snapshot()->problems();
+        setValidityWarnings(problems);
+        return problems.isEmpty();
+    }
+    const QStringList &files() const { return m_files; }
+
+private:
+    QStringList m_files;
+};
+
+// resident memory of the test process, 0 where /proc is not available
+qint64 residentMB()
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text))
+        return 0;
+    while (!status.atEnd()) {
+        QByteArray line = status.readLine();
+        if (line.startsWith("VmRSS:"))
+            return line.mid(6).trimmed().split(' ').first().toLongLong() / 1024;
+    }
+    return 0;
+}
+
+} // namespace
+
+class ScalabilityTest : public ::testing::TestWithParam<int>
+{
+protected:
+    std::shared_ptr<TabComponents> newTab(const QFileInfo &file)
+    {
+        // blocks take their types from the uid manager of the current tab
+        auto tab = std::make_shared<TabComponents>(nullptr, file);
+        TabManager::instance().addTab(tab);
+        m_tabs.push_back(tab);
+        return tab;
+    }
+    void TearDown() override
+    {
+        for (const auto &tab : m_tabs)
+            TabManager::instance().removeTab(*tab);
+        m_tabs.clear();
+        // tabs delete their parts later, there is no event loop running them
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+    // checks the stage against its budget and records the time in the test report
+    void expectWithin(const char *stage, qint64 msecs, double budgetPerThousand)
+    {
+        double budget = budgetPerThousand * GetParam() / 1000.0;
+        RecordProperty(std::string(stage) + "_ms", int(msecs));
+        EXPECT_LE(msecs, budget) << stage << " of " << GetParam() << " blocks is over budget";
+    }
+
+    QTemporaryDir m_dir;
+    std::vector<std::shared_ptr<TabComponents>> m_tabs;
+};
+
+TEST_P(ScalabilityTest, StagesStayWithinBudget)
+{
+    const int blocks = GetParam();
+    ASSERT_TRUE(m_dir.isValid());
+    QFileInfo file(m_dir.filePath(QString("scalability_%1.dcb").arg(blocks)));
+    CodegenEngine engine;
+    qint64 startMB = residentMB();
+    QElapsedTimer timer;
+
+    auto tab = newTab(file);
+    timer.start();
+    ASSERT_TRUE(populate(*tab->getGraph(), blocks).valid) << "Generated graph is not valid";
+    expectWithin("build", timer.elapsed(), BUILD_MSECS);
+
+    timer.restart();
+    ASSERT_TRUE(engine.validityCheck(tab)) << engine.getValidityWarnings().join('\n').toStdString();
+    expectWithin("validate", timer.elapsed(), VALIDATE_MSECS);
+
+    timer.restart();
+    ASSERT_TRUE(engine.execute(tab));
+    expectWithin("codegen", timer.elapsed(), CODEGEN_MSECS);
+    ASSERT_EQ(engine.files().size(), 3);
+    EXPECT_FALSE(engine.files().last().isEmpty());
+
+    timer.restart();
+    ASSERT_TRUE(tab->save());
+    expectWithin("save", timer.elapsed(), SAVE_MSECS);
+
+    auto reopened = newTab(file);
+    timer.restart();
+    ASSERT_TRUE(reopened->openExisting());
+    expectWithin("open", timer.elapsed(), OPEN_MSECS);
+    CustomGraph *graph = reopened->getGraph();
+    ASSERT_EQ(graph->allNodeIds().size(), tab->getGraph()->allNodeIds().size());
+
+    // rename a few blocks and reconnect the shared target, which retypes every trainer
+    timer.restart();
+    {
+        GraphUpdate update(graph);
+        int renamed = 0;
+        for (auto id : graph->allNodeIds()) {
+            auto block = graph->delegateModel<FdfBlockModel>(id);
+            if (block->name() == "trainer" && renamed++ < 10)
+                block->setCaption("edited");
+        }
+        auto target = graph->getBlockByCaption(io_names::DATA_SOURCE);
+        ASSERT_NE(target, nullptr);
+        for (auto id : graph->allNodeIds()) {
+            if (graph->delegateModel<FdfBlockModel>(id) != target)
+                continue;
+            auto connections = graph->allConnectionIds(id);
+            for (const auto &connection : connections)
+                graph->deleteConnection(connection);
+            for (const auto &connection : connections)
+                graph->addConnection(connection);
+        }
+    }
+    graph->revalidate();
+    expectWithin("edit", timer.elapsed(), EDIT_MSECS);
+
+    timer.restart();
+    EXPECT_TRUE(engine.validityCheck(reopened))
+        << engine.getValidityWarnings().join('\n').toStdString();
+    expectWithin("revalidate", timer.elapsed(), VALIDATE_MSECS);
+
+    // resident memory does not shrink after a test, only the first size of a process is measured
+    static bool measured = false;
+    qint64 usedMB = residentMB() - startMB;
+    RecordProperty("memory_mb", int(usedMB));
+    if (!std::exchange(measured, true))
+        EXPECT_LE(usedMB, MEMORY_MB * blocks / 1000.0)
+            << "Two tabs of " << blocks << " blocks use " << usedMB << " MB";
+}
+
+// the sizes are also listed in CMakeLists.txt
+INSTANTIATE_TEST_SUITE_P(SyntheticGraphs,
+                         ScalabilityTest,
+                         ::testing::Values(1000, 5000, 10000),
+                         [](const ::testing::TestParamInfo<int> &info) {
+                             return std::to_string(info.param) + "_blocks";
+                         });
@@ -0,0 +1,198 @@
+#include "engine/codegen.hpp"
+#include "engine/kedro.hpp"
+#include "ui/models/fdf_block_model.hpp"
+#include "ui/models/function_names.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+using Index = GraphSnapshot::Index;
+
+std::shared_ptr<const SnapshotNode> makeNode(QtNodes::NodeId id,
+                                             FdfBlockModel::FdfType type,
+                                             const QString &caption,
+                                             const QString &name = QString(),
+                                             const QStringList &inputs = {},
+                                             const QStringList &outputs = {},
+                                             const QString &parameter = QString())
+{
+    auto node = std::make_shared<SnapshotNode>();
+    node->id = id;
+    node->type = type;
+    node->caption = caption;
+    node->name = name;
+    node->typeName = "processor";
+    node->inputs = inputs;
+    node->outputs = outputs;
+    node->hasParameters = !parameter.isEmpty();
+    if (node->hasParameters)
+        node->parameters = {{"param", parameter}};
+    return node;
+}
+
+} // namespace
+
+TEST(CodegenTest, FusesSingleConsumerChains)
+{
+    using Type = FdfBlockModel::FdfType;
+    // data -> a -> b -> c -> out, d and f both feed e only, g feeds h and i
+    std::vector<std::shared_ptr<const SnapshotNode>> nodes
+        = {makeNode(0, Type::Data, "data"),
+           makeNode(1, Type::Processor, "a"),
+           makeNode(2, Type::Trainer, "b"),
+           makeNode(3, Type::Processor, "c"),
+           makeNode(4, Type::Output, "out"),
+           makeNode(5, Type::Processor, "d"),
+           makeNode(6, Type::Processor, "e"),
+           makeNode(7, Type::Processor, "f"),
+           makeNode(8, Type::Coder, "g"),
+           makeNode(9, Type::Processor, "h"),
+           makeNode(10, Type::Processor, "i")};
+    std::vector<QtNodes::ConnectionId> connections = {{0, 0, 1, 0},
+                                                      {1, 0, 2, 0},
+                                                      {1, 1, 2, 1},
+                                                      {2, 0, 3, 0},
+                                                      {3, 0, 4, 0},
+                                                      {5, 0, 6, 0},
+                                                      {7, 0, 6, 1},
+                                                      {8, 0, 9, 0},
+                                                      {8, 0, 10, 0}};
+    GraphSnapshot snapshot(nodes, connections, false);
+
+    auto chains = codegen::fusableChains(snapshot);
+    ASSERT_EQ(chains.size(), 1u) << "Only a -> b -> c has single consumer links.";
+    auto index = [&snapshot](QtNodes::NodeId id) { return snapshot.indexOf(id).value(); };
+    EXPECT_EQ(chains.front(), (codegen::Chain{index(1), index(2), index(3)}));
+    EXPECT_EQ(codegen::describe(snapshot, chains.front()), "a -> b -> c");
+
+    QString pipeline = Kedro::serializePipeline(snapshot, codegen::Plan{{}, {}, {}, chains});
+    EXPECT_TRUE(pipeline.contains(R"(), [["a","b","c"]]))"));
+    EXPECT_FALSE(pipeline.contains("name=\"out\"")) << "Output blocks are not pipeline nodes.";
+    EXPECT_TRUE(pipeline.contains("from kedro_umbrella import processor\n"));
+    EXPECT_FALSE(pipeline.contains("import *")) << "No block uses a library or workspace function.";
+    EXPECT_TRUE(Kedro::serializePipeline(snapshot).contains("), []))"));
+}
+
+TEST(CodegenTest, SkipsBlocksNoSinkUses)
+{
+    using Type = FdfBlockModel::FdfType;
+    // data -> a -> score, a -> b -> c is a branch without a sink, d is on its own
+    std::vector<std::shared_ptr<const SnapshotNode>> nodes
+        = {makeNode(0, Type::Data, "data"),
+           makeNode(1, Type::Processor, "a"),
+           makeNode(2, Type::Processor, "score", processor_function::SCORE),
+           makeNode(3, Type::Processor, "b"),
+           makeNode(4, Type::Processor, "c"),
+           makeNode(5, Type::Coder, "d")};
+    std::vector<QtNodes::ConnectionId> connections
+        = {{0, 0, 1, 0}, {1, 0, 2, 0}, {1, 0, 3, 0}, {3, 0, 4, 0}};
+    GraphSnapshot snapshot(nodes, connections, false);
+
+    auto sinks = codegen::sinks(snapshot);
+    ASSERT_EQ(sinks.size(), 1u);
+    codegen::Plan plan;
+    plan.included = codegen::upstreamClosure(snapshot, sinks);
+    std::vector<bool> expected = {true, true, true, false, false, false};
+    for (QtNodes::NodeId id = 0; id < nodes.size(); ++id)
+        EXPECT_EQ(plan.included[snapshot.indexOf(id).value()], expected[id]) << id;
+    // only the connectivity of the included blocks counts
+    EXPECT_TRUE(snapshot.problems(plan.included).isEmpty());
+    auto withD = plan.included;
+    withD[snapshot.indexOf(5).value()] = true;
+    EXPECT_TRUE(snapshot.problems(withD).join('\n').contains("not connected"));
+
+    // the skipped branch no longer keeps a from fusing with the score
+    EXPECT_EQ(codegen::fusableChains(snapshot).size(), 1u) << "Only b -> c fuses in the graph.";
+    plan.fused = codegen::fusableChains(snapshot, plan);
+    ASSERT_EQ(plan.fused.size(), 1u);
+    EXPECT_EQ(codegen::describe(snapshot, plan.fused.front()), "a -> score");
+
+    QString pipeline = Kedro::serializePipeline(snapshot, plan);
+    EXPECT_TRUE(pipeline.contains("name=\"a\""));
+    for (const auto &skipped : {"b", "c", "d"})
+        EXPECT_FALSE(pipeline.contains(QString("name=\"%1\"").arg(skipped))) << skipped;
+
+    // running to b needs a but neither the score nor c
+    auto toB = codegen::upstreamClosure(snapshot, {snapshot.indexOf(3).value()});
+    expected = {true, true, false, true, false, false};
+    for (QtNodes::NodeId id = 0; id < nodes.size(); ++id)
+        EXPECT_EQ(toB[snapshot.indexOf(id).value()], expected[id]) << id;
+}
+
+TEST(CodegenTest, MergesIdenticalBlocks)
+{
+    using Type = FdfBlockModel::FdfType;
+    // a pasted copy of the x -> split -> score branch, and a transform with other parameters
+    std::vector<std::shared_ptr<const SnapshotNode>> nodes
+        = {makeNode(0, Type::Data, "data", io_names::DATA_SOURCE, {}, {"raw"}),
+           makeNode(1, Type::Coder, "x", "transform", {"raw"}, {"x_out"}, "1"),
+           makeNode(2, Type::Coder, "x copy", "transform", {"raw"}, {"x_copy_out"}, "1"),
+           makeNode(3, Type::Coder, "x other", "transform", {"raw"}, {"x_other_out"}, "2"),
+           makeNode(4, Type::Processor, "split", "split", {"x_out"}, {"s_a", "s_b"}),
+           makeNode(5, Type::Processor, "split copy", "split", {"x_copy_out"}, {"c_a", "c_b"}),
+           makeNode(6, Type::Processor, "score", processor_function::SCORE, {"s_a", "s_b"}, {}),
+           makeNode(7,
+                    Type::Processor,
+                    "score copy",
+                    processor_function::SCORE,
+                    {"c_a", "c_b"},
+                    {}),
+           makeNode(8,
+                    Type::Processor,
+                    "score other",
+                    processor_function::SCORE,
+                    {"x_other_out"},
+                    {})};
+    std::vector<QtNodes::ConnectionId> connections = {{0, 0, 1, 0},
+                                                      {0, 0, 2, 0},
+                                                      {0, 0, 3, 0},
+                                                      {1, 0, 4, 0},
+                                                      {2, 0, 5, 0},
+                                                      {4, 0, 6, 0},
+                                                      {4, 1, 6, 1},
+                                                      {5, 0, 7, 0},
+                                                      {5, 1, 7, 1},
+                                                      {3, 0, 8, 0}};
+    GraphSnapshot snapshot(nodes, connections, true);
+    auto index = [&snapshot](QtNodes::NodeId id) { return snapshot.indexOf(id).value(); };
+
+    codegen::Plan plan;
+    auto merged = codegen::mergeDuplicates(snapshot, plan);
+    ASSERT_EQ(merged.size(), 2u) << "The split copy becomes identical once x copy is merged.";
+    EXPECT_EQ(merged[0], std::make_pair(index(2), index(1)));
+    EXPECT_EQ(merged[1], std::make_pair(index(5), index(4)));
+    EXPECT_EQ(plan.resultOf(index(5)), index(4));
+    EXPECT_TRUE(plan.includes(index(7))) << "Sinks are never merged.";
+    // the score copy is only connected through the merged blocks, which are still checked
+    EXPECT_TRUE(snapshot.problems(plan.included).join('\n').contains("not connected"));
+    EXPECT_TRUE(snapshot.problems(plan.requested()).isEmpty());
+
+    QString pipeline = Kedro::serializePipeline(snapshot, plan);
+    EXPECT_FALSE(pipeline.contains("name=\"x copy\""));
+    EXPECT_FALSE(pipeline.contains("name=\"split copy\""));
+    EXPECT_TRUE(pipeline.contains("name=\"x other\""));
+    EXPECT_TRUE(pipeline.contains(R"(name="score copy",inputs=["s_a","s_b"])"));
+
+    // both scores read the split now, it cannot be fused into either
+    for (const auto &chain : codegen::fusableChains(snapshot, plan))
+        EXPECT_NE(chain.front(), index(4)) << codegen::describe(snapshot, chain).toStdString();
+}
+
+TEST(CodegenTest, ValidatesPlanAfterMerges)
+{
+    using Type = FdfBlockModel::FdfType;
+    // a -> b1, a -> b2 -> score, b2 computes the same as b1
+    std::vector<std::shared_ptr<const SnapshotNode>> nodes
+        = {makeNode(0, Type::Data, "a", io_names::DATA_SOURCE, {}, {"raw"}),
+           makeNode(1, Type::Processor, "b1", "split", {"raw"}, {"b1_out"}),
+           makeNode(2, Type::Processor, "b2", "split", {"raw"}, {"b2_out"}),
+           makeNode(3, Type::Processor, "score", processor_function::SCORE, {"b2_out"}, {})};
+    std::vector<QtNodes::ConnectionId> connections = {{0, 0, 1, 0}, {0, 0, 2, 0}, {2, 0, 3, 0}};
+    GraphSnapshot snapshot(nodes, connections, true);
+
+    codegen::Plan plan;
+    ASSERT_EQ(codegen::mergeDuplicates(snapshot, plan).size(), 1u);
+    EXPECT_FALSE(plan.includes(snapshot.indexOf(2).value()));
+    EXPECT_TRUE(snapshot.problems(plan.requested()).isEmpty())
+        << snapshot.problems(plan.requested()).join('\n').toStdString();
+}
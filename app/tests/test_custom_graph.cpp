@@ -0,0 +1,105 @@
+#include "data/block_manager.hpp"
+#include "data/custom_graph.hpp"
+#include "ui/models/fdf_block_model.hpp"
+#include <gtest/gtest.h>
+
+#include <QtNodes/NodeDelegateModelRegistry>
+
+TEST(CustomGraphTest, CopiesGetIncreasingSuffixes)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    auto first = graph.addNode("transform");
+    auto second = graph.addNode("transform");
+    auto third = graph.addNode("transform");
+
+    EXPECT_EQ(graph.delegateModel<FdfBlockModel>(first)->caption(), "transform");
+    EXPECT_EQ(graph.delegateModel<FdfBlockModel>(second)->caption(), "transform_2");
+    EXPECT_EQ(graph.delegateModel<FdfBlockModel>(third)->caption(), "transform_3");
+}
+
+TEST(CustomGraphTest, DeletedNodeReleasesCaptionAndPorts)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    auto first = graph.addNode("transform");
+    auto second = graph.addNode("transform");
+    auto secondBlock = graph.delegateModel<FdfBlockModel>(second);
+    QString secondCaption = secondBlock->caption();
+    QString secondPort = secondBlock->portCaption(PortType::Out, 0);
+
+    graph.deleteNode(first);
+    EXPECT_EQ(graph.getBlockByCaption("transform"), nullptr)
+        << "Caption of a deleted node should be released.";
+    EXPECT_EQ(graph.getBlockByCaption(secondCaption), secondBlock);
+
+    // the released names are free again, the remaining node keeps its own
+    auto third = graph.addNode("transform");
+    auto thirdBlock = graph.delegateModel<FdfBlockModel>(third);
+    EXPECT_EQ(thirdBlock->caption(), "transform");
+    EXPECT_NE(thirdBlock->portCaption(PortType::Out, 0), secondPort);
+}
+
+TEST(CustomGraphTest, UpdatePropagatesDirtyBlockOnceOnCommit)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    auto node = graph.addNode("transform");
+    auto block = graph.delegateModel<FdfBlockModel>(node);
+    int updates = 0;
+    QObject::connect(block, &FdfBlockModel::dataUpdated, [&updates](PortIndex) { ++updates; });
+
+    {
+        GraphUpdate outer(&graph);
+        GraphUpdate inner(&graph);
+        block->propagateUpdate();
+        block->propagateUpdate();
+        EXPECT_EQ(updates, 0) << "Propagation should be deferred while the update is open.";
+    }
+    EXPECT_EQ(updates, int(block->nPorts(PortType::Out)));
+}
+
+TEST(CustomGraphTest, SnapshotOnlyCopiesChangedBlocks)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    auto first = graph.addNode("transform");
+    auto second = graph.addNode("transform");
+
+    auto before = graph.snapshot();
+    ASSERT_EQ(before->size(), 2u);
+    EXPECT_EQ(graph.snapshot(), before) << "Unchanged graph should reuse the snapshot.";
+
+    graph.delegateModel<FdfBlockModel>(second)->setCaption("renamed");
+    auto after = graph.snapshot();
+    ASSERT_NE(after, before);
+    auto firstIndex = after->indexOf(first);
+    auto secondIndex = after->indexOf(second);
+    ASSERT_TRUE(firstIndex && secondIndex);
+    EXPECT_EQ(&after->node(*firstIndex), &before->node(*before->indexOf(first)));
+    EXPECT_EQ(after->node(*secondIndex).caption, "renamed");
+    EXPECT_EQ(before->node(*before->indexOf(second)).caption, "transform_2")
+        << "Snapshots handed out should not change.";
+}
+
+TEST(CustomGraphTest, ComponentsFollowConnections)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    auto coder = graph.addNode("transform");
+    auto output = graph.addNode("func_out");
+    EXPECT_EQ(graph.componentCount(), 2u);
+
+    QtNodes::ConnectionId connection{coder, 0, output, 0};
+    graph.addConnection(connection);
+    EXPECT_EQ(graph.componentCount(), 1u);
+    graph.deleteConnection(connection);
+    EXPECT_EQ(graph.componentCount(), 2u);
+}
+
+TEST(CustomGraphTest, SnapshotReportsAllProblems)
+{
+    CustomGraph graph(BlockManager::getRegistry());
+    graph.addNode("transform");
+    graph.addNode("transform");
+
+    // two unconnected blocks, each with a missing input
+    auto problems = graph.snapshot()->problems();
+    EXPECT_EQ(problems.size(), 3) << problems.join('\n').toStdString();
+    EXPECT_TRUE(problems.first().contains("not connected"));
+}
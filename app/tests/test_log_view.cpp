@@ -0,0 +1,45 @@
+#include "data/log_store.hpp"
+#include "ui/log_view.hpp"
+#include <gtest/gtest.h>
+
+TEST(LogStoreTest, SplitsLinesAndKeepsTypes)
+{
+    LogStore store;
+    EXPECT_EQ(store.append("first\r\nsecond\n", QtWarningMsg), 2u);
+    EXPECT_EQ(store.append("ünïcode", QtInfoMsg), 1u);
+    ASSERT_EQ(store.size(), 3u);
+    EXPECT_EQ(store.line(0), "first");
+    EXPECT_EQ(store.line(1), "second");
+    EXPECT_EQ(store.line(2), "ünïcode");
+    EXPECT_EQ(store.type(1), QtWarningMsg);
+    EXPECT_TRUE(store.contains(0, "FIRST"));
+    EXPECT_FALSE(store.contains(1, "first"));
+
+    // reads after more appends go past the mapped end
+    store.append("third", QtCriticalMsg);
+    EXPECT_EQ(store.line(3), "third");
+
+    // "Ã" is c3 83 and "ッ" is e3 83 83 in utf-8, only ascii letters are folded
+    store.append("ッ", QtInfoMsg);
+    EXPECT_FALSE(store.contains(4, QString("Ã").toUtf8()));
+    EXPECT_FALSE(store.contains(2, QString("ÜNÏ").toUtf8()));
+    EXPECT_TRUE(store.contains(2, QString("ünïCODE").toUtf8()));
+}
+
+TEST(LogStoreTest, FilteredModelOnlyShowsMatchingLines)
+{
+    LogModel model;
+    model.append({{"run started", QtInfoMsg}, {"missing file", QtWarningMsg}});
+    model.setFilter(QString(), QtWarningMsg);
+    ASSERT_EQ(model.rowCount(), 1);
+    EXPECT_EQ(model.index(0).data().toString(), "missing file");
+
+    model.append({{"node failed", QtCriticalMsg}, {"run finished", QtInfoMsg}});
+    EXPECT_EQ(model.rowCount(), 2) << "Appends should be checked against the filter.";
+    EXPECT_EQ(model.find("FAILED", -1, false), 1);
+
+    model.setFilter("run", QtDebugMsg);
+    EXPECT_EQ(model.rowCount(), 2);
+    model.setFilter(QString(), QtDebugMsg);
+    EXPECT_EQ(model.rowCount(), 4);
+}
@@ -0,0 +1,49 @@
+#include "engine/preview.hpp"
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace {
+
+QByteArrayList readLines(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    return file.readAll().trimmed().split('\n');
+}
+
+} // namespace
+
+TEST(PreviewTest, SamplesCsvRowsWithTheSeed)
+{
+    QTemporaryDir dir;
+    const QString source = QDir(dir.path()).filePath("data.csv");
+    {
+        QFile file(source);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("x,y\n");
+        for (int i = 0; i < 100; ++i)
+            file.write(QByteArray::number(i) + ',' + QByteArray::number(i * i) + '\n');
+    }
+    auto sample = [&dir, &source](int rows, quint32 seed) {
+        QString name = QString("sample_%1_%2.csv").arg(rows).arg(seed);
+        QString destination = QDir(dir.path()).filePath(name);
+        EXPECT_TRUE(preview::sampleCsv(source, destination, rows, seed));
+        return readLines(destination);
+    };
+
+    auto lines = sample(10, 7);
+    ASSERT_EQ(lines.size(), 11);
+    EXPECT_EQ(lines.front(), "x,y");
+    int previous = -1;
+    for (int i = 1; i < lines.size(); ++i) {
+        int row = lines[i].split(',').front().toInt();
+        EXPECT_GT(row, previous) << "Rows should keep their order.";
+        previous = row;
+    }
+    EXPECT_EQ(lines, sample(10, 7));
+    EXPECT_NE(lines, sample(10, 8));
+    EXPECT_EQ(sample(1000, 7).size(), 101) << "Every row is kept when there are few.";
+}
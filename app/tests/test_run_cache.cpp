@@ -0,0 +1,104 @@
+#include "engine/run_cache.hpp"
+#include <gtest/gtest.h>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+namespace {
+
+void writeFile(const QString &path, const QByteArray &contents)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(contents);
+}
+
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+} // namespace
+
+TEST(RunCacheTest, FingerprintCoversEveryInput)
+{
+    QTemporaryDir dir;
+    writeFile(dir.filePath("data.csv"), "x,y\n1,2\n");
+
+    auto fingerprint = [&dir](const QByteArray &pipeline) {
+        RunCache::Fingerprint fingerprint;
+        fingerprint.add("pipeline", pipeline);
+        EXPECT_TRUE(fingerprint.addFile("data", dir.filePath("data.csv")));
+        return fingerprint.result();
+    };
+    QString key = fingerprint("a");
+    EXPECT_EQ(key, fingerprint("a"));
+    EXPECT_NE(key, fingerprint("b"));
+    writeFile(dir.filePath("data.csv"), "x,y\n1,3\n");
+    EXPECT_NE(key, fingerprint("a")) << "Changed data should change the fingerprint.";
+
+    RunCache::Fingerprint missing;
+    EXPECT_FALSE(missing.addFile("data", dir.filePath("missing.csv")));
+}
+
+TEST(RunCacheTest, RestoresStoredOutputs)
+{
+    QTemporaryDir root, first, second;
+    RunCache cache(root.path());
+    QDir project(first.path());
+    writeFile(project.filePath("data/08_reporting/score/score.yml"), "mse: 0.5\n");
+    writeFile(project.filePath("data/08_reporting/score/plot.png"), "png");
+    writeFile(project.filePath("data/06_models/model.dill"), "dill");
+    const QStringList outputs = {"data/08_reporting/score", "data/06_models/model.dill"};
+    const QString key = "0123abcd";
+
+    EXPECT_FALSE(cache.contains(key));
+    ASSERT_TRUE(cache.store(key, project, outputs));
+    EXPECT_TRUE(cache.contains(key));
+
+    // another builder instance shares the entry through the same root
+    RunCache other(root.path());
+    QDir otherProject(second.path());
+    writeFile(otherProject.filePath("data/08_reporting/score/stale.png"), "old");
+    ASSERT_TRUE(other.restore(key, otherProject, outputs));
+    EXPECT_EQ(readFile(otherProject.filePath("data/08_reporting/score/score.yml")), "mse: 0.5\n");
+    EXPECT_EQ(readFile(otherProject.filePath("data/08_reporting/score/plot.png")), "png");
+    EXPECT_EQ(readFile(otherProject.filePath("data/06_models/model.dill")), "dill");
+    EXPECT_FALSE(otherProject.exists("data/08_reporting/score/stale.png"))
+        << "Outputs of earlier runs should be replaced.";
+    EXPECT_FALSE(other.restore("unknown", otherProject, outputs));
+}
+
+TEST(RunCacheTest, EvictsLeastRecentlyUsedEntries)
+{
+    QTemporaryDir root, dir;
+    RunCache cache(root.path(), 10);
+    QDir project(dir.path());
+    writeFile(project.filePath("out.txt"), "four");
+    // the marks of an entry date its last use, set them apart explicitly
+    auto usedAt = [&root](const QString &key, int secondsAgo) {
+        QFile mark(QDir(root.path()).filePath(key + ".used"));
+        ASSERT_TRUE(mark.open(QIODevice::ReadWrite));
+        mark.setFileTime(QDateTime::currentDateTime().addSecs(-secondsAgo),
+                         QFileDevice::FileModificationTime);
+    };
+    ASSERT_TRUE(cache.store("a", project, {"out.txt"}));
+    usedAt("a", 30);
+    ASSERT_TRUE(cache.store("b", project, {"out.txt"}));
+    usedAt("b", 20);
+    ASSERT_TRUE(cache.restore("a", project, {"out.txt"}));
+    usedAt("a", 10);
+
+    ASSERT_TRUE(cache.store("c", project, {"out.txt"}));
+    EXPECT_TRUE(cache.contains("c"));
+    EXPECT_TRUE(cache.contains("a")) << "Restoring an entry counts as a use.";
+    EXPECT_FALSE(cache.contains("b")) << "Three entries do not fit in 10 bytes.";
+
+    RunCache expiring(root.path(), RunCache::DEFAULT_MAX_BYTES, 0);
+    expiring.evict("c");
+    EXPECT_FALSE(cache.contains("a")) << "Entries unused for longer than the age cap are removed.";
+    EXPECT_TRUE(cache.contains("c"));
+}
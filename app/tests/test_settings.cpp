@@ -0,0 +1,45 @@
+#include "data/settings.hpp"
+#include <gtest/gtest.h>
+#include <QObject>
+
+#include <thread>
+
+namespace {
+const QString KEY = "engine timeout (minutes)";
+} // namespace
+
+TEST(SettingsTest, SnapshotsStayUnchangedAfterWrites)
+{
+    auto &settings = data::Settings::instance();
+    const int original = settings.get<int>(KEY);
+    auto before = settings.snapshot();
+
+    QObject context;
+    QVariant notified;
+    int notifications = 0;
+    settings.subscribe(KEY, &context, [&](const QVariant &value) {
+        notified = value;
+        ++notifications;
+    });
+    settings.setValue(KEY, original + 1);
+    EXPECT_EQ(settings.get<int>(KEY), original + 1);
+    EXPECT_EQ(before->at(KEY).toInt(), original) << "Snapshots handed out should not change.";
+    EXPECT_EQ(notified.toInt(), original + 1);
+    settings.setValue(KEY, original + 1);
+    EXPECT_EQ(notifications, 1) << "Writing the same value should not notify.";
+
+    // readers on other threads only ever see whole values
+    std::thread reader([&settings, original]() {
+        for (int i = 0; i < 10000; ++i) {
+            int value = settings.get<int>(KEY);
+            ASSERT_TRUE(value == original || value == original + 1);
+        }
+    });
+    for (int i = 0; i < 100; ++i)
+        settings.setValue(KEY, original + i % 2);
+    reader.join();
+
+    settings.setValue(KEY, original);
+    settings.flush();
+    EXPECT_EQ(settings.get<int>(KEY), original);
+}
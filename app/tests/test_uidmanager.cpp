@@ -45,6 +45,72 @@ TEST(UIDManagerTest, UpdateMapOverridesTag)
     EXPECT_EQ(uidManager.getTag(id), "updated_tag");
 }
 
+TEST(UIDManagerTest, OverrideResolvesToCanonicalType)
+{
+    UIDManager uidManager;
+    FdfUID keepId = uidManager.createUID("keep_tag");
+    FdfUID middleId = uidManager.createUID("middle_tag");
+    FdfUID removeId = uidManager.createUID("remove_tag");
+
+    QString middleTag = "middle_tag";
+    uidManager.updateMap(removeId, middleTag);
+    QString keepTag = "keep_tag";
+    uidManager.updateMap(middleId, keepTag);
+
+    // the ids are kept, chains of overrides resolve to the oldest type
+    EXPECT_EQ(uidManager.resolve(removeId), keepId);
+    EXPECT_EQ(uidManager.resolve(middleId), keepId);
+    EXPECT_EQ(uidManager.getTag(removeId), "keep_tag");
+    EXPECT_EQ(uidManager.getUid("remove_tag"), UIDManager::NONE_ID);
+    EXPECT_GT(uidManager.createUID(), removeId) << "Overridden UIDs must not be reused.";
+
+    // undoing the second override keeps the first one
+    ASSERT_TRUE(uidManager.undoLastOverride());
+    EXPECT_EQ(uidManager.resolve(middleId), middleId);
+    EXPECT_EQ(uidManager.resolve(removeId), middleId);
+}
+
+TEST(UIDManagerTest, UndoOverrideRestoresType)
+{
+    UIDManager uidManager;
+    FdfUID keepId = uidManager.createUID("keep_tag");
+    FdfUID removeId = uidManager.createUID("remove_tag");
+
+    QString keepTag = "keep_tag";
+    uidManager.updateMap(removeId, keepTag);
+    ASSERT_EQ(uidManager.resolve(removeId), keepId);
+
+    ASSERT_TRUE(uidManager.undoLastOverride());
+    EXPECT_EQ(uidManager.resolve(removeId), removeId);
+    EXPECT_EQ(uidManager.getTag(removeId), "remove_tag");
+    EXPECT_EQ(uidManager.getTag(keepId), "keep_tag");
+    EXPECT_FALSE(uidManager.undoLastOverride());
+}
+
+TEST(UIDManagerTest, UndoRestoresCompressedPaths)
+{
+    UIDManager uidManager;
+    std::vector<FdfUID> ids;
+    for (const auto &tag : {"t0", "t1", "t2", "t3"})
+        ids.push_back(uidManager.createUID(tag));
+    QString t0 = "t0", t2 = "t2";
+    uidManager.updateMap(ids[1], t0);
+    uidManager.updateMap(ids[3], t2);
+    uidManager.updateMap(ids[2], t0);
+    for (auto id : ids)
+        ASSERT_EQ(uidManager.resolve(id), ids[0]);
+
+    // renaming through the deepest type compresses its path, undo puts it back
+    QString renamed = "renamed";
+    uidManager.updateMap(ids[3], renamed);
+    EXPECT_EQ(uidManager.getTag(ids[0]), "renamed");
+    ASSERT_TRUE(uidManager.undoLastOverride());
+    EXPECT_EQ(uidManager.resolve(ids[3]), ids[2]);
+    EXPECT_EQ(uidManager.resolve(ids[1]), ids[0]);
+    EXPECT_EQ(uidManager.getTag(ids[2]), "t2");
+    EXPECT_EQ(uidManager.getTag(ids[0]), "renamed");
+}
+
 TEST(UIDManagerTest, ReusingTagCreatesUniqueUID)
 {
     UIDManager uidManager;